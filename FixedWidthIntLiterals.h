@@ -20,7 +20,8 @@
 ////////////////////////////////////////////////////////////////////////////////
 /// This file contains an implementation to support fixed-size integer literal suffixes.
 ///
-/// Implemented suffixes include u8, u16, u32, u64, z, i8, i16, i32, i64.
+/// Implemented suffixes include u8, u16, u32, u64, z, i8, i16, i32, i64, and the
+/// decimal-scaled d2, d4, d6, d8, which give int64_t counts of 10^-2 (and so on) units.
 /// The 'z' type is size_t per the C++11 printf convention described in
 /// https://en.cppreference.com/w/cpp/io/c/fprintf
 ///
@@ -40,6 +41,7 @@
 ///  auto iy = 100_i64; // iy is typed as int64_t
 ///  auto iz = -50_i8; // iz is typed as int8_t
 ///  auto sz = 100_z; // sz is typed as size_t
+///  auto px = 19.99_d2; // px is int64_t 1999
 ///
 /// Code Design Notes
 /// -----------------
@@ -52,6 +54,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <type_traits>
 
 #ifndef SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE
 #define SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE scw
@@ -64,17 +67,160 @@ namespace detail {
 using u64 = std::uint64_t;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Calculates value*value
-constexpr u64 sqrOf(u64 value) {
-  return value * value;
+/// Calculates: value^n, wrapping like T does. Only used to fill the tables below.
+template <typename T>
+constexpr T powerOf(T value, unsigned n) {
+  return n == 0 ? T{1} : powerOf<T>(value, n / 2u) * powerOf<T>(value, n / 2u) * (n % 2 == 0 ? T{1} : value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Calculates: value^n
-constexpr u64 powerOf(u64 value, u64 n) {
-  return n == 0 ? u64{1} : sqrOf(powerOf(value, n / 2u)) * u64{n % 2 == 0 ? 1 : value};
+/// Number of radix digits needed to write value.
+template <typename T>
+constexpr unsigned digitsOf(T value, unsigned radix) {
+  return value < radix ? 1u : 1u + digitsOf<T>(value / radix, radix);
 }
 
+template <unsigned... kIndex>
+struct IndexList {};
+
+template <unsigned kCount, unsigned... kIndex>
+struct MakeIndexList : MakeIndexList<kCount - 1, kCount - 1, kIndex...> {};
+
+template <unsigned... kIndex>
+struct MakeIndexList<0, kIndex...> {
+  using type = IndexList<kIndex...>;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// The tables proper, one entry per digit count n. A value written as a high part
+/// followed by n more digits fits T when high < kHighLimit[n], or when it's equal and
+/// the n digits are at most kLowLimit[n].
+template <typename T, unsigned kRadix, typename Indices>
+struct RadixPowerTable;
+
+template <typename T, unsigned kRadix, unsigned... kIndex>
+struct RadixPowerTable<T, kRadix, IndexList<kIndex...>> {
+  static constexpr T kPower[] = {powerOf<T>(kRadix, kIndex)...};
+  static constexpr T kHighLimit[] = {static_cast<T>(~T{0} / powerOf<T>(kRadix, kIndex))...};
+  static constexpr T kLowLimit[] = {static_cast<T>(~T{0} % powerOf<T>(kRadix, kIndex))...};
+};
+
+#if !defined(__cpp_inline_variables) || __cpp_inline_variables < 201606L
+template <typename T, unsigned kRadix, unsigned... kIndex>
+constexpr T RadixPowerTable<T, kRadix, IndexList<kIndex...>>::kPower[];
+template <typename T, unsigned kRadix, unsigned... kIndex>
+constexpr T RadixPowerTable<T, kRadix, IndexList<kIndex...>>::kHighLimit[];
+template <typename T, unsigned kRadix, unsigned... kIndex>
+constexpr T RadixPowerTable<T, kRadix, IndexList<kIndex...>>::kLowLimit[];
+#endif
+
+}  // namespace detail
+}  // namespace intliterals
+
+////////////////////////////////////////////////////////////////////////////////
+/// Powers of a radix and the per-digit-count limits of an unsigned T, as constexpr
+/// tables that land in .rodata once. The literal parser below indexes them instead of
+/// recomputing kRadix^n for every digit, and the runtime kernels in FixedWidthIntParse.h
+/// check overflow against the same tables.
+///
+///  using Powers = RadixPowers<std::uint64_t, 10>;
+///  Powers::kDigits;              // 20, the digits in the largest value
+///  Powers::kSafeDigits;          // 19, any string of up to this many digits fits
+///  Powers::kPower[16];           // 10^16, for indexes below kDigits
+///  Powers::fits(1844, low, 16);  // 1844 * 10^16 + low fits, given low < 10^16
+///
+/// T may also be unsigned __int128 where the compiler has it.
+template <typename T, unsigned kRadix>
+struct RadixPowers
+    : intliterals::detail::RadixPowerTable<
+          T, kRadix, typename intliterals::detail::MakeIndexList<intliterals::detail::digitsOf<T>(~T{0}, kRadix)>::type> {
+  static constexpr unsigned kDigits = intliterals::detail::digitsOf<T>(~T{0}, kRadix);
+  static constexpr unsigned kSafeDigits =
+      RadixPowers::kHighLimit[kDigits - 1] == kRadix - 1 &&
+              RadixPowers::kLowLimit[kDigits - 1] == RadixPowers::kPower[kDigits - 1] - 1
+          ? kDigits
+          : kDigits - 1;
+
+  /// kRadix^n, or 0 past the table where any nonzero digit overflows.
+  static constexpr T power(unsigned n) { return n < kDigits ? RadixPowers::kPower[n] : T{0}; }
+  static constexpr T highLimit(unsigned n) { return n < kDigits ? RadixPowers::kHighLimit[n] : T{0}; }
+  static constexpr T lowLimit(unsigned n) { return n < kDigits ? RadixPowers::kLowLimit[n] : ~T{0}; }
+
+  /// Whether high * kRadix^n + low fits T, for low < kRadix^n. O(1) per digit count.
+  static constexpr bool fits(T high, T low, unsigned n) {
+    return high < highLimit(n) || (high == highLimit(n) && low <= lowLimit(n));
+  }
+};
+
+#if !defined(__cpp_inline_variables) || __cpp_inline_variables < 201606L
+template <typename T, unsigned kRadix>
+constexpr unsigned RadixPowers<T, kRadix>::kDigits;
+template <typename T, unsigned kRadix>
+constexpr unsigned RadixPowers<T, kRadix>::kSafeDigits;
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// A UUID as two integers: high is the first sixteen hex digits of the text and low
+/// the last sixteen, so comparing them orders UUIDs the way their text sorts, and
+/// writing both big endian gives the RFC 4122 bytes. The _uuid literal and the runtime
+/// intparse::parseUuid both produce it.
+struct Uuid {
+  std::uint64_t high;
+  std::uint64_t low;
+};
+
+constexpr bool operator==(const Uuid& a, const Uuid& b) {
+  return a.high == b.high && a.low == b.low;
+}
+
+constexpr bool operator!=(const Uuid& a, const Uuid& b) {
+  return !(a == b);
+}
+
+constexpr bool operator<(const Uuid& a, const Uuid& b) {
+  return a.high < b.high || (a.high == b.high && a.low < b.low);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// A set of CPUs, or of any numbers below 1024, as bit n % 64 of words[n / 64]. That's
+/// the size and layout of glibc's cpu_set_t on 64-bit Linux, so it copies straight
+/// into one. The _cpuset literal and the runtime intparse::parseCpuList both produce it.
+constexpr std::size_t kCpuSetWords = 16;
+
+struct CpuSet {
+  std::uint64_t words[kCpuSetWords];
+
+  constexpr bool contains(std::size_t cpu) const {
+    return cpu < 64 * kCpuSetWords && (words[cpu / 64] >> (cpu % 64) & 1) != 0;
+  }
+};
+
+namespace intliterals {
+namespace detail {
+
+constexpr bool equalWords(const std::uint64_t* a, const std::uint64_t* b, std::size_t count) {
+  return count == 0 || (*a == *b && equalWords(a + 1, b + 1, count - 1));
+}
+
+}  // namespace detail
+}  // namespace intliterals
+
+constexpr bool operator==(const CpuSet& a, const CpuSet& b) {
+  return intliterals::detail::equalWords(a.words, b.words, kCpuSetWords);
+}
+
+constexpr bool operator!=(const CpuSet& a, const CpuSet& b) {
+  return !(a == b);
+}
+
+namespace intliterals {
+using SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::CpuSet;
+using SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::Uuid;
+}  // namespace intliterals
+
+namespace intliterals {
+namespace detail {
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Convert the incoming char digit value to the proper numerical value. This function
 /// handles 0-9,a-f,A-F digits... so everything.
@@ -83,27 +229,114 @@ constexpr u64 digitToValue(char kDigit) {
       kDigit - '0' : ((kDigit >= 'a' && kDigit <= 'f') ? kDigit - 'a' + 10 : kDigit - 'A' + 10));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Digit values for the identifier alphabets, which go past hexadecimal. Base-36 is 0-9
+/// then a-z. Crockford base-32 leaves out I, L, O, and U, and reads I and L as 1 and O
+/// as 0 since that's what people mean when they type them. Both ignore case, and anything
+/// outside the alphabet maps to 0xff.
+constexpr unsigned charCode(char ch) {
+  return static_cast<unsigned char>(ch);
+}
+
+constexpr unsigned base36ToValue(char ch) {
+  return charCode(ch) - '0' < 10u ? charCode(ch) - '0' :
+      (charCode(ch) | 0x20u) - 'a' < 26u ? (charCode(ch) | 0x20u) - 'a' + 10 : 0xffu;
+}
+
+constexpr unsigned crockfordLetterToValue(unsigned letter) {
+  return letter == 'i' || letter == 'l' ? 1u : letter == 'o' ? 0u : letter == 'u' ? 0xffu :
+      letter - 'a' + 10 - (letter > 'i') - (letter > 'l') - (letter > 'o') - (letter > 'u');
+}
+
+constexpr unsigned crockfordToValue(char ch) {
+  return base36ToValue(ch) < 10u ? base36ToValue(ch) :
+      base36ToValue(ch) < 36u ? crockfordLetterToValue(charCode(ch) | 0x20u) : 0xffu;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The text hash behind the _h64 literal and intparse::hash64. The steps are shared and
+/// only the word loads differ, so the two agree bit for bit. Keys of up to 16 characters
+/// are mixed in one step over two words that overlap when the key is short; longer keys
+/// take a step per 16 bytes and finish on the last 16. Words are little endian.
+constexpr u64 kHashSeed = 0x9e3779b97f4a7c15u;
+constexpr u64 kHashMul1 = 0xff51afd7ed558ccdu;
+constexpr u64 kHashMul2 = 0xc4ceb9fe1a85ec53u;
+
+constexpr u64 rotateLeft(u64 value, unsigned shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+constexpr u64 hashStep(u64 hash, u64 first, u64 second) {
+  return (rotateLeft((hash ^ first) * kHashMul1, 29) ^ second) * kHashMul2;
+}
+
+constexpr u64 xorShift33(u64 value) {
+  return value ^ (value >> 33);
+}
+
+constexpr u64 hashFinish(u64 hash) {
+  return xorShift33(xorShift33(xorShift33(hash) * kHashMul1) * kHashMul2);
+}
+
+/// Up to three characters as one word: the first, the middle, and the last.
+constexpr u64 hashTiny(const char* text, std::size_t length) {
+  return length == 0 ? u64{0} :
+      (u64{charCode(text[0])} << 16) | (u64{charCode(text[length / 2])} << 8) | charCode(text[length - 1]);
+}
+
+constexpr u64 textWord(const char* text, unsigned bytes) {
+  return bytes == 0 ? u64{0} : (u64{charCode(text[bytes - 1])} << (8 * (bytes - 1))) | textWord(text, bytes - 1);
+}
+
+constexpr u64 hashShortText(const char* text, std::size_t length, u64 hash) {
+  return length >= 8 ? hashStep(hash, textWord(text, 8), textWord(text + length - 8, 8)) :
+      length >= 4 ? hashStep(hash, textWord(text, 4), textWord(text + length - 4, 4)) :
+      hashStep(hash, hashTiny(text, length), 0);
+}
+
+constexpr u64 hashLongText(const char* text, std::size_t length, std::size_t at, u64 hash) {
+  return length - at > 16 ?
+      hashLongText(text, length, at + 16, hashStep(hash, textWord(text + at, 8), textWord(text + at + 8, 8))) :
+      hashStep(hash, textWord(text + length - 16, 8), textWord(text + length - 8, 8));
+}
+
+constexpr u64 hashText(const char* text, std::size_t length) {
+  return hashFinish(length <= 16 ? hashShortText(text, length, kHashSeed ^ length) :
+                                   hashLongText(text, length, 0, kHashSeed ^ length));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Integer parser that knows the correct base of the incoming digits, and
 /// kDigits will contain only the final digits to parse. We have two specializations
-/// of this to facilitate recursion.
-template <u64 kRadix, char... kDigits>
+/// of this to facilitate recursion. Next to parse() each has fits(), which says
+/// whether the digits fit in 64 bits at all.
+template <unsigned kRadix, char... kDigits>
 struct ParseIntegerValue;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Specialization for only one digit - the recursion base case.
-template <u64 kRadix, char kDigit>
+template <unsigned kRadix, char kDigit>
 struct ParseIntegerValue<kRadix, kDigit> {
   static constexpr u64 parse() { return digitToValue(kDigit); }
+  static constexpr bool fits() { return true; }
 };
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Specialization for multiple digits that recurses.
-template <u64 kRadix, char kDigit, char... kDigits>
+/// Specialization for multiple digits that recurses. Only the leading digit of a
+/// full length value can reach its limit, so the rest of the digits are only
+/// parsed a second time for that one.
+template <unsigned kRadix, char kDigit, char... kDigits>
 struct ParseIntegerValue<kRadix, kDigit, kDigits...> {
+  using Powers = RadixPowers<u64, kRadix>;
+  using Rest = ParseIntegerValue<kRadix, kDigits...>;
+
   static constexpr u64 parse() {
-    return (digitToValue(kDigit) * powerOf(kRadix, u64{sizeof...(kDigits)})) +
-           ParseIntegerValue<kRadix, kDigits...>::parse();
+    return (digitToValue(kDigit) * Powers::power(sizeof...(kDigits))) + Rest::parse();
+  }
+  static constexpr bool fits() {
+    return Rest::fits() && (digitToValue(kDigit) < Powers::highLimit(sizeof...(kDigits)) ||
+                            (digitToValue(kDigit) == Powers::highLimit(sizeof...(kDigits)) &&
+                             Rest::parse() <= Powers::lowLimit(sizeof...(kDigits))));
   }
 };
 
@@ -126,21 +359,96 @@ struct ParseBaseUnknown<'0', 'X', kDigits...> : public ParseIntegerValue<16, kDi
 ////////////////////////////////////////////////////////////////////////////////
 /// The base function to kick off parsing of the digits. This handles the case of just a single
 /// digit vs more than one digit. For a single digit, we can just hand it to the base-10
-/// parser. Otherwise we let the appropriate parse specialization handle it.
+/// parser. Otherwise we let the appropriate parse specialization handle it. Digits that
+/// don't fit 64 bits would otherwise wrap and sail past the checks below, so they stop here.
 template <char... kDigits>
 constexpr u64 createValue() {
-  return std::conditional<(sizeof...(kDigits) > 1), ParseBaseUnknown<kDigits...>,
-                            ParseIntegerValue<10, kDigits...>>::type::parse();
+  using Parser = typename std::conditional<(sizeof...(kDigits) > 1), ParseBaseUnknown<kDigits...>,
+                                           ParseIntegerValue<10, kDigits...>>::type;
+  static_assert(Parser::fits(), "integer literal doesn't fit in 64 bits.");
+  return Parser::parse();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Decimal-scaled literals (19.99_d2) get the characters of a floating literal, or of an
+/// integer one. They're folded left to right into the digits as one integer, how many of
+/// those came after the point, and what went wrong, so no floating point is involved.
+struct DecimalState {
+  u64 value;
+  unsigned digits;
+  unsigned fraction;
+  bool seenPoint;
+  bool leadingZero;
+  bool valid;
+  bool fits;
+};
+
+constexpr DecimalState decimalDigitStep(DecimalState state, unsigned digit) {
+  return DecimalState{state.value * 10 + digit, state.digits + 1, state.fraction + (state.seenPoint ? 1u : 0u),
+                      state.seenPoint, state.leadingZero || (state.digits == 0 && digit == 0 && !state.seenPoint),
+                      state.valid, state.fits && RadixPowers<u64, 10>::fits(state.value, digit, 1)};
+}
+
+constexpr DecimalState decimalStep(DecimalState state, char ch) {
+  return ch >= '0' && ch <= '9' ? decimalDigitStep(state, static_cast<unsigned>(ch - '0')) :
+      ch == '.' && !state.seenPoint ? DecimalState{state.value, state.digits, state.fraction, true,
+                                                   state.leadingZero, state.valid, state.fits} :
+      DecimalState{state.value, state.digits, state.fraction, state.seenPoint, state.leadingZero, false, state.fits};
 }
 
+template <char... kChars>
+struct ParseDecimalState;
+
+template <>
+struct ParseDecimalState<> {
+  static constexpr DecimalState parse(DecimalState state) { return state; }
+};
+
+template <char kChar, char... kChars>
+struct ParseDecimalState<kChar, kChars...> {
+  static constexpr DecimalState parse(DecimalState state) {
+    return ParseDecimalState<kChars...>::parse(decimalStep(state, kChar));
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// The literal's value in units of 10^-kScale, before the range check of the type.
+/// A leading zero without a point would be an octal integer literal, which is surely
+/// not what anyone writing a price meant.
+template <unsigned kScale, char... kChars>
+struct ScaledDecimalValue {
+  using Powers = RadixPowers<u64, 10>;
+  static constexpr DecimalState kState =
+      ParseDecimalState<kChars...>::parse(DecimalState{0, 0, 0, false, false, true, true});
+  static constexpr unsigned kPadDigits = kState.fraction <= kScale ? kScale - kState.fraction : 0;
+
+  static_assert(kScale < Powers::kDigits, "decimal scale too large for 64 bits.");
+  static_assert(kState.valid && !(kState.leadingZero && kState.digits > 1 && !kState.seenPoint),
+                "decimal literal must be plain decimal digits with an optional point.");
+  static_assert(kState.fraction <= kScale, "decimal literal has more fractional digits than its scale.");
+  static_assert(kState.fits && Powers::fits(kState.value, 0, kPadDigits), "decimal literal doesn't fit in 64 bits.");
+
+  static constexpr u64 parse() { return kState.value * Powers::kPower[kPadDigits]; }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Sigh the macro... Can't get a string into a static_assert with a template param,
 /// it must be literal, and I don't want to copy/paste the function.
+///
+/// Each check also gets a policy struct, turning a spelling into its checked value, so
+/// the memoized values below can be keyed on it. They're keyed on the check rather than
+/// the type since size_t usually aliases one of the fixed width types, and each suffix
+/// should keep its own error message.
 #define SCW_FIXEDWIDTH_DEFINE_CHECK_VALID_FUNC(typename_, errorMessage_)                      \
   template <u64 kValue>                                                            \
   constexpr typename_ checkValid_##typename_() {                                   \
     static_assert(kValue <= std::numeric_limits<typename_>::max(), errorMessage_); \
     return static_cast<typename_>(kValue);                                         \
+  }                                                                                \
+  struct CheckValid_##typename_ {                                                  \
+    using type = typename_;                                                        \
+    template <char... kChars>                                                      \
+    static constexpr typename_ value() { return checkValid_##typename_<createValue<kChars...>()>(); } \
   }
 
 // clang-format off
@@ -155,6 +463,37 @@ SCW_FIXEDWIDTH_DEFINE_CHECK_VALID_FUNC(int64_t, "int64 literal out of range. Not
 SCW_FIXEDWIDTH_DEFINE_CHECK_VALID_FUNC(size_t, "size_t literal out of range.");
 // clang-format on
 
+/// The decimal-scaled spellings parse to a count of 10^-kScale units, checked as int64_t.
+template <unsigned kScale>
+struct CheckValidScaled {
+  using type = int64_t;
+  template <char... kChars>
+  static constexpr int64_t value() {
+    return checkValid_int64_t<ScaledDecimalValue<kScale, kChars...>::parse()>();
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// The checked value of each distinct literal spelling, computed once per TU. Every
+/// later use of the same literal (think 4096_z all over a file) reads the variable
+/// instead of re-entering constant evaluation of the parse and checkValid_*().
+/// C++17 gets an inline variable template; before that a static member does the job.
+#if defined(__cpp_inline_variables) && __cpp_inline_variables >= 201606L
+template <typename Check, char... kDigits>
+inline constexpr typename Check::type literal_v = Check::template value<kDigits...>();
+
+#define SCW_FIXEDWIDTH_LITERAL_VALUE(check_, digits_) detail::literal_v<detail::check_, digits_...>
+#else
+template <typename Check, char... kDigits>
+struct LiteralValue {
+  static constexpr typename Check::type value = Check::template value<kDigits...>();
+};
+template <typename Check, char... kDigits>
+constexpr typename Check::type LiteralValue<Check, kDigits...>::value;
+
+#define SCW_FIXEDWIDTH_LITERAL_VALUE(check_, digits_) detail::LiteralValue<detail::check_, digits_...>::value
+#endif
+
 }  // namespace detail
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -162,7 +501,7 @@ SCW_FIXEDWIDTH_DEFINE_CHECK_VALID_FUNC(size_t, "size_t literal out of range.");
 #define SCW_FIXEDWIDTH_DEFINE_INTEGER_OPERATOR(typesuffix_, typename_)                \
   template <char... digits>                                                \
   constexpr typename_ operator"" typesuffix_() {                        \
-    return detail::checkValid_##typename_<detail::createValue<digits...>()>(); \
+    return SCW_FIXEDWIDTH_LITERAL_VALUE(CheckValid_##typename_, digits);       \
   }
 
 // clang-format off
@@ -177,6 +516,22 @@ SCW_FIXEDWIDTH_DEFINE_INTEGER_OPERATOR(_i64, int64_t);
 SCW_FIXEDWIDTH_DEFINE_INTEGER_OPERATOR(_z, size_t);
 // clang-format on
 
+////////////////////////////////////////////////////////////////////////////////
+/// Decimal-scaled operators: the literal as an int64_t count of 10^-scale units, so
+/// 19.99_d2 is 1999 and 0.00000001_d8 is 1. Exact, as the digits are never a double.
+#define SCW_FIXEDWIDTH_DEFINE_SCALED_OPERATOR(typesuffix_, scale_)                      \
+  template <char... digits>                                                            \
+  constexpr int64_t operator"" typesuffix_() {                                         \
+    return SCW_FIXEDWIDTH_LITERAL_VALUE(CheckValidScaled<scale_>, digits);              \
+  }
+
+// clang-format off
+SCW_FIXEDWIDTH_DEFINE_SCALED_OPERATOR(_d2, 2);
+SCW_FIXEDWIDTH_DEFINE_SCALED_OPERATOR(_d4, 4);
+SCW_FIXEDWIDTH_DEFINE_SCALED_OPERATOR(_d6, 6);
+SCW_FIXEDWIDTH_DEFINE_SCALED_OPERATOR(_d8, 8);
+// clang-format on
+
 }  // namespace intliterals
 }  // namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE
 
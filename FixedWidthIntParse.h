@@ -0,0 +1,2974 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// This file contains the runtime counterpart of FixedWidthIntLiterals.h: parsing and
+/// formatting of integer text when the digits aren't known until the program runs.
+///
+/// Every operation has a ladder of kernels, from portable scalar code through SWAR
+/// (eight digits per 64-bit word) to SSE4.1, AVX2 and AVX-512 where the operation has
+/// something to gain from them. The kernels are resolved once, on first use, against
+/// what cpuid reports. Setting the environment variable SCW_INTLIT_ISA to one of
+/// scalar, swar, sse41, avx2 or avx512 caps the tier, which makes it possible to A/B
+/// kernels in production or reproduce what a customer's machine runs. It can only
+/// lower the tier; asking for an ISA the CPU lacks is ignored.
+///
+/// Parsing takes exactly the digits: no sign, prefix, or surrounding whitespace.
+/// Errors are reported through ParseError rather than exceptions, matching how the
+/// literal side reports through static_assert and never throws.
+///
+/// Examples
+/// --------
+///  #include "FixedWidthIntParse.h"
+///  using namespace scw::intparse;
+///  std::uint64_t value;
+///  ParseError error = parseDecimal("4096", 4, value);  // value == 4096
+///  char text[kMaxDecimalChars];
+///  std::size_t length = formatHex(value, text);       // "1000"
+///  Isa isa = activeKernelIsa(KernelOp::ParseDecimal); // what's running
+///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "FixedWidthIntLiterals.h"
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#if defined(SCW_FIXEDWIDTH_INT_LITERALS_STATS)
+#include <atomic>
+#include <new>
+#endif
+
+#ifndef SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE
+#define SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE scw
+#endif
+
+// The SIMD kernels are compiled per function with target attributes, so the rest of
+// the program needs no special flags to use them. They move 64-bit lanes through
+// general registers, so 32-bit x86 builds get the scalar and SWAR kernels only.
+#if !defined(SCW_INTLIT_NO_X86_KERNELS) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SCW_INTLIT_X86_KERNELS 1
+#include <immintrin.h>
+#define SCW_INTLIT_TARGET(isa_) __attribute__((target(isa_)))
+#else
+#define SCW_INTLIT_X86_KERNELS 0
+#endif
+
+// Columns parsed into a std::pmr::memory_resource need C++17 and a library that has one.
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#define SCW_INTLIT_HAS_PMR 1
+#include <algorithm>
+#include <memory_resource>
+#endif
+#endif
+#ifndef SCW_INTLIT_HAS_PMR
+#define SCW_INTLIT_HAS_PMR 0
+#endif
+
+namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE {
+namespace intparse {
+
+using u64 = std::uint64_t;
+
+enum class ParseError : std::uint8_t {
+  None,
+  Empty,         // No digits at all
+  InvalidDigit,  // A character that isn't a digit of the radix
+  Overflow,      // Valid digits, but the value doesn't fit the type
+};
+
+/// An IPv6 address in network byte order, the layout of in6_addr.
+struct Ipv6Address {
+  std::uint8_t bytes[16];
+};
+
+inline bool operator==(const Ipv6Address& a, const Ipv6Address& b) {
+  return std::memcmp(a.bytes, b.bytes, sizeof(a.bytes)) == 0;
+}
+
+/// The value types the _uuid and _cpuset literals share, so both sides compare directly.
+using SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::CpuSet;
+using SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::Uuid;
+
+/// Longest output of the formatters, and the buffer size callers need.
+constexpr std::size_t kMaxDecimalChars = 20;
+constexpr std::size_t kMaxHexChars = 16;
+constexpr std::size_t kMaxBinaryChars = 64;
+constexpr std::size_t kMaxBase36Chars = 13;
+constexpr std::size_t kMaxBase32Chars = 13;
+constexpr std::size_t kMaxIpv4Chars = 15;
+constexpr std::size_t kMaxIpv6Chars = 45;
+constexpr std::size_t kUuidChars = 36;
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 u128;
+__extension__ typedef __int128 i128;
+
+/// 128-bit formatting: 39 digits and a sign, 32 hex digits, 128 binary digits.
+constexpr std::size_t kMaxDecimal128Chars = 40;
+constexpr std::size_t kMaxHex128Chars = 32;
+constexpr std::size_t kMaxBinary128Chars = 128;
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Kernel tiers, in increasing order of what the CPU has to support.
+enum class Isa : std::uint8_t { Scalar, Swar, Sse41, Avx2, Avx512 };
+
+////////////////////////////////////////////////////////////////////////////////
+/// The dispatched operations.
+enum class KernelOp : std::uint8_t {
+  ParseDecimal,
+  ParseHex,
+  ParseBinary,
+  FormatDecimal,
+  FormatHex,
+  ParseIpv4,
+  ParseIpv6,
+  ParseUuid,
+  FormatUuid,
+  ParseDecimalBatch,
+  MatchRows,
+};
+constexpr std::size_t kKernelOpCount = 11;
+
+using ParseKernel = ParseError (*)(const char* digits, std::size_t length, u64& value);
+using FormatKernel = std::size_t (*)(u64 value, char* out);
+using Ipv4ParseKernel = ParseError (*)(const char* text, std::size_t length, std::uint32_t& address);
+using Ipv6ParseKernel = ParseError (*)(const char* text, std::size_t length, Ipv6Address& address);
+using UuidParseKernel = ParseError (*)(const char* text, std::size_t length, Uuid& uuid);
+using UuidFormatKernel = void (*)(const Uuid& uuid, char* out);
+
+/// Batch parsing lays up to kBatchRows tokens out as rows of kBatchRowChars digits,
+/// right aligned and padded with '0'. A rows kernel converts count of them, and the
+/// rows after them up to a multiple of four, returning a bit per invalid row.
+constexpr std::size_t kBatchRows = 16;
+constexpr std::size_t kBatchRowChars = 16;
+using RowsParseKernel = unsigned (*)(const char (*rows)[kBatchRowChars], std::size_t count, u64* values);
+
+/// Filters test a block's kBatchRows parsed values, returning a bit per value that has
+/// lowest <= value <= lowest + span, or (value & mask) == expected.
+using RowsRangeKernel = unsigned (*)(const u64* values, u64 lowest, u64 span);
+using RowsMaskedKernel = unsigned (*)(const u64* values, u64 mask, u64 expected);
+
+inline const char* isaName(Isa isa) {
+  switch (isa) {
+    case Isa::Scalar: return "scalar";
+    case Isa::Swar: return "swar";
+    case Isa::Sse41: return "sse41";
+    case Isa::Avx2: return "avx2";
+    case Isa::Avx512: return "avx512";
+  }
+  return "?";
+}
+
+inline const char* kernelOpName(KernelOp op) {
+  switch (op) {
+    case KernelOp::ParseDecimal: return "parse-decimal";
+    case KernelOp::ParseHex: return "parse-hex";
+    case KernelOp::ParseBinary: return "parse-binary";
+    case KernelOp::FormatDecimal: return "format-decimal";
+    case KernelOp::FormatHex: return "format-hex";
+    case KernelOp::ParseIpv4: return "parse-ipv4";
+    case KernelOp::ParseIpv6: return "parse-ipv6";
+    case KernelOp::ParseUuid: return "parse-uuid";
+    case KernelOp::FormatUuid: return "format-uuid";
+    case KernelOp::ParseDecimalBatch: return "parse-decimal-batch";
+    case KernelOp::MatchRows: return "match-rows";
+  }
+  return "?";
+}
+
+namespace detail {
+
+/// The radix tables shared with the literal parser, for the overflow checks.
+using Powers2 = RadixPowers<u64, 2>;
+using Powers10 = RadixPowers<u64, 10>;
+using Powers16 = RadixPowers<u64, 16>;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Runtime twin of intliterals::detail::digitToValue, except that anything that isn't
+/// a digit maps to 0xff so callers can range check against their radix.
+inline unsigned digitValue(char ch) {
+  const unsigned c = static_cast<unsigned char>(ch);
+  return c - '0' < 10u ? c - '0' : (c | 0x20u) - 'a' < 6u ? (c | 0x20u) - 'a' + 10u : 0xffu;
+}
+
+inline u64 load32(const char* p) {
+  std::uint32_t word;
+  std::memcpy(&word, p, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  word = __builtin_bswap32(word);
+#endif
+  return word;
+}
+
+inline u64 load64(const char* p) {
+  u64 word;
+  std::memcpy(&word, p, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  word = __builtin_bswap64(word);
+#endif
+  return word;
+}
+
+inline void store64(char* p, u64 word) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  word = __builtin_bswap64(word);
+#endif
+  std::memcpy(p, &word, sizeof(word));
+}
+
+inline u64 byteSwap64(u64 value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap64(value);
+#else
+  value = ((value & 0x00ff00ff00ff00ffu) << 8) | ((value >> 8) & 0x00ff00ff00ff00ffu);
+  value = ((value & 0x0000ffff0000ffffu) << 16) | ((value >> 16) & 0x0000ffff0000ffffu);
+  return (value << 32) | (value >> 32);
+#endif
+}
+
+inline unsigned countLeadingZeros(u64 value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_clzll(value));
+#else
+  unsigned count = 0;
+  for (u64 bit = u64{1} << 63; (value & bit) == 0; bit >>= 1) {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+inline unsigned countTrailingZeros(u64 value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_ctzll(value));
+#else
+  unsigned count = 0;
+  for (; (value & 1) == 0; value >>= 1) {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Leading zeros never change the value, and skipping them up front means the
+/// kernels below only have to think about overflow by length.
+inline void skipLeadingZeros(const char*& digits, std::size_t& length) {
+  while (length > 1 && *digits == '0') {
+    ++digits;
+    --length;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Scalar kernels. These are the reference the others are tested against, and
+/// what the wider kernels fall back to for the digits they don't cover. kDigitValue is
+/// there for the identifier alphabets, which go past hexadecimal.
+template <unsigned kRadix, unsigned (*kDigitValue)(char) = digitValue>
+ParseError parseScalar(const char* digits, std::size_t length, u64& value) {
+  using Powers = RadixPowers<u64, kRadix>;
+  if (length == 0) {
+    return ParseError::Empty;
+  }
+  u64 acc = 0;
+  for (std::size_t i = 0; i < length; ++i) {
+    const unsigned digit = kDigitValue(digits[i]);
+    if (digit >= kRadix) {
+      return ParseError::InvalidDigit;
+    }
+    acc = acc * kRadix + digit;
+  }
+  // Up to kSafeDigits can't overflow, so the common case skips the checks. Past that
+  // only significant digits count, and a full length value is checked once against the
+  // limits for its leading digit; acc has wrapped, but only by whole multiples of 2^64.
+  if (length > Powers::kSafeDigits) {
+    while (length > 1 && kDigitValue(*digits) == 0) {
+      ++digits;
+      --length;
+    }
+    if (length > Powers::kDigits) {
+      return ParseError::Overflow;
+    }
+    if (length > Powers::kSafeDigits) {
+      const u64 high = kDigitValue(digits[0]);
+      const unsigned lowDigits = static_cast<unsigned>(length - 1);
+      if (!Powers::fits(high, acc - high * Powers::kPower[lowDigits], lowDigits)) {
+        return ParseError::Overflow;
+      }
+    }
+  }
+  value = acc;
+  return ParseError::None;
+}
+
+inline std::size_t formatDecimalScalar(u64 value, char* out) {
+  static const char kPairs[] =
+      "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+      "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+      "8081828384858687888990919293949596979899";
+  char buffer[kMaxDecimalChars];
+  char* p = buffer + kMaxDecimalChars;
+  while (value >= 100) {
+    const unsigned pair = static_cast<unsigned>(value % 100) * 2;
+    value /= 100;
+    *--p = kPairs[pair + 1];
+    *--p = kPairs[pair];
+  }
+  if (value >= 10) {
+    const unsigned pair = static_cast<unsigned>(value) * 2;
+    *--p = kPairs[pair + 1];
+    *--p = kPairs[pair];
+  } else {
+    *--p = static_cast<char>('0' + value);
+  }
+  const std::size_t length = static_cast<std::size_t>(buffer + kMaxDecimalChars - p);
+  std::memcpy(out, p, length);
+  return length;
+}
+
+inline std::size_t formatHexScalar(u64 value, char* out) {
+  static const char kHexDigits[] = "0123456789abcdef";
+  char buffer[kMaxHexChars];
+  char* p = buffer + kMaxHexChars;
+  do {
+    *--p = kHexDigits[value & 0xf];
+    value >>= 4;
+  } while (value != 0);
+  const std::size_t length = static_cast<std::size_t>(buffer + kMaxHexChars - p);
+  std::memcpy(out, p, length);
+  return length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Identifier codecs for base-36 and Crockford base-32. Decoding is one lookup per
+/// character in a 256-entry table generated from the literal side's digit functions,
+/// so a literal and its runtime parse can't disagree. Base-36 encodes in lower case and
+/// Crockford in upper case, as each is usually written.
+template <unsigned kRadix, typename Indices>
+struct IdentifierDigitTable;
+
+template <unsigned kRadix, unsigned... kIndex>
+struct IdentifierDigitTable<kRadix, intliterals::detail::IndexList<kIndex...>> {
+  static constexpr std::uint8_t kValue[] = {static_cast<std::uint8_t>(
+      kRadix == 36 ? intliterals::detail::base36ToValue(static_cast<char>(kIndex))
+                   : intliterals::detail::crockfordToValue(static_cast<char>(kIndex)))...};
+};
+
+template <unsigned kRadix>
+struct IdentifierDigits : IdentifierDigitTable<kRadix, intliterals::detail::MakeIndexList<256>::type> {
+  static_assert(kRadix == 36 || kRadix == 32, "Only base-36 and Crockford base-32 are supported");
+  static constexpr const char* kChars =
+      kRadix == 36 ? "0123456789abcdefghijklmnopqrstuvwxyz" : "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+
+  static unsigned value(char ch) { return IdentifierDigits::kValue[static_cast<unsigned char>(ch)]; }
+};
+
+#if !defined(__cpp_inline_variables) || __cpp_inline_variables < 201606L
+template <unsigned kRadix, unsigned... kIndex>
+constexpr std::uint8_t IdentifierDigitTable<kRadix, intliterals::detail::IndexList<kIndex...>>::kValue[];
+template <unsigned kRadix>
+constexpr const char* IdentifierDigits<kRadix>::kChars;
+#endif
+
+template <unsigned kRadix>
+inline ParseError parseIdentifier(const char* digits, std::size_t length, u64& value) {
+  return parseScalar<kRadix, IdentifierDigits<kRadix>::value>(digits, length, value);
+}
+
+template <unsigned kRadix>
+inline std::size_t formatIdentifier(u64 value, char* out) {
+  const std::size_t kMaxChars = RadixPowers<u64, kRadix>::kDigits;
+  char buffer[kMaxChars];
+  char* p = buffer + kMaxChars;
+  do {
+    *--p = IdentifierDigits<kRadix>::kChars[value % kRadix];
+    value /= kRadix;
+  } while (value != 0);
+  const std::size_t length = static_cast<std::size_t>(buffer + kMaxChars - p);
+  std::memcpy(out, p, length);
+  return length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Address text, strict the way inet_pton is: IPv4 is four dotted decimal octets with
+/// no leading zeros; IPv6 is up to eight hextets of one to four hex digits, at most one
+/// "::", and optionally a dotted IPv4 tail. Malformed text is InvalidDigit and an
+/// octet past 255 is Overflow. These scalar kernels are the reference for the SSE4.1
+/// ones, which also fall back to them for anything out of the ordinary.
+inline ParseError parseIpv4Scalar(const char* text, std::size_t length, std::uint32_t& address) {
+  if (length == 0) {
+    return ParseError::Empty;
+  }
+  std::uint8_t octets[4];
+  bool overflow = false;
+  std::size_t at = 0;
+  for (std::size_t i = 0; i < 4; ++i) {
+    if (i != 0 && (at == length || text[at++] != '.')) {
+      return ParseError::InvalidDigit;
+    }
+    const std::size_t start = at;
+    unsigned value = 0;
+    while (at < length && at - start < 3 && static_cast<unsigned>(text[at] - '0') < 10u) {
+      value = value * 10 + static_cast<unsigned>(text[at++] - '0');
+    }
+    if (at == start || (text[start] == '0' && at - start > 1)) {
+      return ParseError::InvalidDigit;
+    }
+    overflow = overflow || value > 255;
+    octets[i] = static_cast<std::uint8_t>(value);
+  }
+  if (at != length) {
+    return ParseError::InvalidDigit;
+  }
+  if (overflow) {
+    return ParseError::Overflow;
+  }
+  std::memcpy(&address, octets, sizeof(address));
+  return ParseError::None;
+}
+
+/// Spreads the hextets before a "::" gap out to the full address, zero filling the gap.
+inline bool finishIpv6(const std::uint16_t (&words)[8], std::size_t count, std::size_t gap, Ipv6Address& address) {
+  const std::size_t kNoGap = ~std::size_t{0};
+  if (gap == kNoGap ? count != 8 : count == 8) {
+    return false;
+  }
+  const std::size_t moved = gap == kNoGap ? 0 : count - gap;
+  for (std::size_t i = 0; i < 8; ++i) {
+    std::uint16_t word = 0;
+    if (i < count - moved) {
+      word = words[i];
+    } else if (i >= 8 - moved) {
+      word = words[i - (8 - count)];
+    }
+    address.bytes[2 * i] = static_cast<std::uint8_t>(word >> 8);
+    address.bytes[2 * i + 1] = static_cast<std::uint8_t>(word);
+  }
+  return true;
+}
+
+inline ParseError parseIpv6Scalar(const char* text, std::size_t length, Ipv6Address& address) {
+  const std::size_t kNoGap = ~std::size_t{0};
+  if (length == 0) {
+    return ParseError::Empty;
+  }
+  std::size_t at = 0;
+  if (text[0] == ':' && (length < 2 || text[1] != ':')) {
+    return ParseError::InvalidDigit;  // Only "::" may lead
+  }
+  at = text[0] == ':' ? 1 : 0;
+
+  std::uint16_t words[8];
+  std::size_t count = 0;
+  std::size_t gap = kNoGap;
+  std::size_t token = at;
+  unsigned digits = 0;
+  unsigned value = 0;
+  while (at < length) {
+    const char ch = text[at++];
+    const unsigned digit = digitValue(ch);
+    if (digit < 16) {
+      if (++digits > 4) {
+        return ParseError::InvalidDigit;
+      }
+      value = (value << 4) | digit;
+    } else if (ch == ':') {
+      token = at;
+      if (digits == 0) {
+        if (gap != kNoGap) {
+          return ParseError::InvalidDigit;
+        }
+        gap = count;
+        continue;
+      }
+      if (at == length || count == 8) {
+        return ParseError::InvalidDigit;
+      }
+      words[count++] = static_cast<std::uint16_t>(value);
+      digits = 0;
+      value = 0;
+    } else if (ch == '.' && count <= 6) {
+      // The dotted tail is the last two hextets, and has to run to the end
+      std::uint32_t tail;
+      const ParseError error = parseIpv4Scalar(text + token, length - token, tail);
+      if (error != ParseError::None) {
+        return error;
+      }
+      std::uint8_t bytes[4];
+      std::memcpy(bytes, &tail, sizeof(bytes));
+      words[count++] = static_cast<std::uint16_t>((bytes[0] << 8) | bytes[1]);
+      words[count++] = static_cast<std::uint16_t>((bytes[2] << 8) | bytes[3]);
+      digits = 0;
+      break;
+    } else {
+      return ParseError::InvalidDigit;
+    }
+  }
+  if (digits != 0) {
+    if (count == 8) {
+      return ParseError::InvalidDigit;
+    }
+    words[count++] = static_cast<std::uint16_t>(value);
+  }
+  return finishIpv6(words, count, gap, address) ? ParseError::None : ParseError::InvalidDigit;
+}
+
+/// Octet text for the formatters: up to three digits, then the length in the last byte.
+struct OctetText {
+  char text[4];
+};
+
+constexpr OctetText octetText(unsigned octet) {
+  return octet >= 100 ? OctetText{{static_cast<char>('0' + octet / 100), static_cast<char>('0' + octet / 10 % 10),
+                                   static_cast<char>('0' + octet % 10), 3}} :
+      octet >= 10 ? OctetText{{static_cast<char>('0' + octet / 10), static_cast<char>('0' + octet % 10), 0, 2}} :
+      OctetText{{static_cast<char>('0' + octet), 0, 0, 1}};
+}
+
+template <typename Indices>
+struct OctetTextTable;
+
+template <unsigned... kIndex>
+struct OctetTextTable<intliterals::detail::IndexList<kIndex...>> {
+  static constexpr OctetText kOctets[] = {octetText(kIndex)...};
+};
+
+#if !defined(__cpp_inline_variables) || __cpp_inline_variables < 201606L
+template <unsigned... kIndex>
+constexpr OctetText OctetTextTable<intliterals::detail::IndexList<kIndex...>>::kOctets[];
+#endif
+
+using OctetTexts = OctetTextTable<intliterals::detail::MakeIndexList<256>::type>;
+
+/// Writes four bytes per octet into a scratch buffer, so there are no per-digit branches.
+inline char* writeIpv4(const std::uint8_t* octets, char* out) {
+  for (std::size_t i = 0; i < 4; ++i) {
+    const OctetText& octet = OctetTexts::kOctets[octets[i]];
+    std::memcpy(out, octet.text, 4);
+    out += octet.text[3];
+    *out++ = '.';
+  }
+  return out - 1;
+}
+
+inline std::size_t formatIpv4Scalar(std::uint32_t address, char* out) {
+  std::uint8_t octets[4];
+  std::memcpy(octets, &address, sizeof(octets));
+  char buffer[kMaxIpv4Chars + 4];
+  const std::size_t length = static_cast<std::size_t>(writeIpv4(octets, buffer) - buffer);
+  std::memcpy(out, buffer, length);
+  return length;
+}
+
+/// RFC 5952 text, as inet_ntop writes it: lower case, no leading zeros, the first of the
+/// longest runs of two or more zero hextets as "::", and a dotted tail for IPv4-mapped
+/// and IPv4-compatible addresses.
+inline std::size_t formatIpv6Scalar(const Ipv6Address& address, char* out) {
+  static const char kHexDigits[] = "0123456789abcdef";
+  unsigned words[8];
+  for (std::size_t i = 0; i < 8; ++i) {
+    words[i] = (unsigned{address.bytes[2 * i]} << 8) | address.bytes[2 * i + 1];
+  }
+  std::size_t bestStart = 8;
+  std::size_t bestLength = 1;
+  for (std::size_t i = 0; i < 8;) {
+    std::size_t run = 0;
+    while (i + run < 8 && words[i + run] == 0) {
+      ++run;
+    }
+    if (run > bestLength) {
+      bestStart = i;
+      bestLength = run;
+    }
+    i += run == 0 ? 1 : run;
+  }
+
+  char buffer[kMaxIpv6Chars + 4];
+  char* p = buffer;
+  for (std::size_t i = 0; i < 8; ++i) {
+    if (i >= bestStart && i < bestStart + bestLength) {
+      if (i == bestStart) {
+        *p++ = ':';
+      }
+      continue;
+    }
+    if (i != 0) {
+      *p++ = ':';
+    }
+    if (i == 6 && bestStart == 0 && (bestLength == 6 || (bestLength == 5 && words[5] == 0xffff))) {
+      p = writeIpv4(address.bytes + 12, p);
+      break;
+    }
+    for (int shift = words[i] >= 0x1000 ? 12 : words[i] >= 0x100 ? 8 : words[i] >= 0x10 ? 4 : 0; shift >= 0;
+         shift -= 4) {
+      *p++ = kHexDigits[(words[i] >> shift) & 0xf];
+    }
+  }
+  if (bestStart + bestLength == 8) {
+    *p++ = ':';
+  }
+  const std::size_t length = static_cast<std::size_t>(p - buffer);
+  std::memcpy(out, buffer, length);
+  return length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// UUID text: exactly 8-4-4-4-12 hex digits, either case in, lower case out.
+inline bool isUuidHyphen(std::size_t at) {
+  return at == 8 || at == 13 || at == 18 || at == 23;
+}
+
+inline ParseError parseUuidScalar(const char* text, std::size_t length, Uuid& uuid) {
+  if (length != kUuidChars) {
+    return length == 0 ? ParseError::Empty : ParseError::InvalidDigit;
+  }
+  u64 halves[2] = {0, 0};
+  std::size_t digits = 0;
+  for (std::size_t i = 0; i < kUuidChars; ++i) {
+    if (isUuidHyphen(i)) {
+      if (text[i] != '-') {
+        return ParseError::InvalidDigit;
+      }
+      continue;
+    }
+    const unsigned digit = digitValue(text[i]);
+    if (digit >= 16) {
+      return ParseError::InvalidDigit;
+    }
+    u64& half = halves[digits++ / 16];
+    half = half << 4 | digit;
+  }
+  uuid = Uuid{halves[0], halves[1]};
+  return ParseError::None;
+}
+
+inline void formatUuidScalar(const Uuid& uuid, char* out) {
+  static const char kHexDigits[] = "0123456789abcdef";
+  std::size_t digits = 0;
+  for (std::size_t i = 0; i < kUuidChars; ++i) {
+    if (isUuidHyphen(i)) {
+      out[i] = '-';
+      continue;
+    }
+    const u64 half = digits < 16 ? uuid.high : uuid.low;
+    out[i] = kHexDigits[(half >> (60 - 4 * (digits++ % 16))) & 0xf];
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// SWAR helpers. A word holds eight characters with the first one in the low byte.
+constexpr u64 kOnes = 0x0101010101010101u;
+constexpr u64 kHighBits = 0x8080808080808080u;
+
+/// High bit of each byte set where lo <= byte <= hi. Bytes must be below 0x80.
+inline u64 bytesInRange(u64 word, unsigned lo, unsigned hi) {
+  return (word + kOnes * (0x80u - lo)) & (kOnes * (0x80u + hi) - word) & kHighBits;
+}
+
+inline bool allDecimal8(u64 word) {
+  return (word & kHighBits) == 0 && bytesInRange(word, '0', '9') == kHighBits;
+}
+
+inline bool allHex8(u64 word) {
+  return (word & kHighBits) == 0 &&
+         (bytesInRange(word, '0', '9') | bytesInRange(word | (kOnes * 0x20u), 'a', 'f')) == kHighBits;
+}
+
+/// Eight decimal characters to their value, three multiplies in total.
+inline u64 decimal8(u64 word) {
+  word -= kOnes * '0';
+  word = (word * 10) + (word >> 8);
+  return (((word & 0x000000ff000000ffu) * (100 + (u64{1000000} << 32))) +
+          (((word >> 16) & 0x000000ff000000ffu) * (1 + (u64{10000} << 32)))) >>
+         32;
+}
+
+/// Eight hex characters to their 32-bit value by folding nibble pairs together.
+inline u64 hex8(u64 word) {
+  word = (word & (kOnes * 0x0fu)) + 9 * ((word >> 6) & kOnes);
+  word = ((word << 4) | (word >> 8)) & 0x00ff00ff00ff00ffu;
+  word = ((word << 8) | (word >> 16)) & 0x0000ffff0000ffffu;
+  return ((word << 16) | (word >> 32)) & 0xffffffffu;
+}
+
+/// Eight '0'/'1' characters to a byte, first character in the high bit.
+inline bool binary8(u64 word, u64& bits) {
+  if ((word & ~kOnes) != kOnes * '0') {
+    return false;
+  }
+  bits = ((word & kOnes) * 0x8040201008040201u) >> 56;
+  return true;
+}
+
+/// A value below 10^8 to its eight ASCII digits, zero padded.
+inline u64 decimalDigits8(u64 value) {
+  u64 word = (value / 10000) | ((value % 10000) << 32);
+  u64 quotient = ((word * 10486) >> 20) & 0x0000007f0000007fu;
+  word = quotient | ((word - quotient * 100) << 16);
+  quotient = ((word * 103) >> 10) & 0x000f000f000f000fu;
+  word = quotient | ((word - quotient * 10) << 8);
+  return word + kOnes * '0';
+}
+
+/// The low 32 bits of value to eight ASCII hex digits.
+inline u64 hexDigits8(u64 value) {
+  u64 word = value & 0xffffffffu;
+  word = (word | (word << 16)) & 0x0000ffff0000ffffu;
+  word = (word | (word << 8)) & 0x00ff00ff00ff00ffu;
+  word = (word | (word << 4)) & 0x0f0f0f0f0f0f0f0fu;
+  word = byteSwap64(word);
+  const u64 letters = ((word + kOnes * 6) >> 4) & kOnes;
+  return word + kOnes * '0' + letters * ('a' - '0' - 10);
+}
+
+inline ParseError parseDecimalSwar(const char* digits, std::size_t length, u64& value) {
+  if (length == 0) {
+    return ParseError::Empty;
+  }
+  skipLeadingZeros(digits, length);
+  if (length > Powers10::kDigits) {
+    return parseScalar<10>(digits, length, value);  // Sorts out invalid vs overflow
+  }
+
+  const std::size_t head = length % 8;
+  u64 acc = 0;
+  if (head != 0 && parseScalar<10>(digits, head, acc) != ParseError::None) {
+    return ParseError::InvalidDigit;
+  }
+  for (std::size_t i = head; i < length; i += 8) {
+    const u64 word = load64(digits + i);
+    if (!allDecimal8(word)) {
+      return ParseError::InvalidDigit;
+    }
+    const u64 chunk = decimal8(word);
+    // Only full length values can overflow, and only on their last chunk
+    if (length > Powers10::kSafeDigits && !Powers10::fits(acc, chunk, 8)) {
+      return ParseError::Overflow;
+    }
+    acc = acc * 100000000u + chunk;
+  }
+  value = acc;
+  return ParseError::None;
+}
+
+inline ParseError parseHexSwar(const char* digits, std::size_t length, u64& value) {
+  if (length == 0) {
+    return ParseError::Empty;
+  }
+  skipLeadingZeros(digits, length);
+  if (length > Powers16::kDigits) {
+    return parseScalar<16>(digits, length, value);
+  }
+
+  const std::size_t head = length % 8;
+  u64 acc = 0;
+  if (head != 0 && parseScalar<16>(digits, head, acc) != ParseError::None) {
+    return ParseError::InvalidDigit;
+  }
+  for (std::size_t i = head; i < length; i += 8) {
+    const u64 word = load64(digits + i);
+    if (!allHex8(word)) {
+      return ParseError::InvalidDigit;
+    }
+    acc = (acc << 32) | hex8(word);
+  }
+  value = acc;
+  return ParseError::None;
+}
+
+inline ParseError parseBinarySwar(const char* digits, std::size_t length, u64& value) {
+  if (length == 0) {
+    return ParseError::Empty;
+  }
+  skipLeadingZeros(digits, length);
+  if (length > Powers2::kDigits) {
+    return parseScalar<2>(digits, length, value);
+  }
+
+  const std::size_t head = length % 8;
+  u64 acc = 0;
+  if (head != 0 && parseScalar<2>(digits, head, acc) != ParseError::None) {
+    return ParseError::InvalidDigit;
+  }
+  for (std::size_t i = head; i < length; i += 8) {
+    u64 bits;
+    if (!binary8(load64(digits + i), bits)) {
+      return ParseError::InvalidDigit;
+    }
+    acc = (acc << 8) | bits;
+  }
+  value = acc;
+  return ParseError::None;
+}
+
+inline std::size_t formatDecimalSwar(u64 value, char* out) {
+  if (value < 100000000u) {
+    if (value == 0) {
+      *out = '0';
+      return 1;
+    }
+    // Leading zero bytes hold exactly '0', so the first nonzero digit falls out of a ctz
+    const u64 word = decimalDigits8(value);
+    const unsigned skip = countTrailingZeros(word - kOnes * '0') / 8;
+    char buffer[8];
+    store64(buffer, word);
+    std::memcpy(out, buffer + skip, 8 - skip);
+    return 8 - skip;
+  }
+
+  std::size_t length;
+  if (value < 10000000000000000u) {
+    length = formatDecimalSwar(value / 100000000u, out);
+  } else {
+    length = formatDecimalScalar(value / 10000000000000000u, out);
+    store64(out + length, decimalDigits8(value / 100000000u % 100000000u));
+    length += 8;
+  }
+  store64(out + length, decimalDigits8(value % 100000000u));
+  return length + 8;
+}
+
+inline std::size_t formatHexSwar(u64 value, char* out) {
+  if (value == 0) {
+    *out = '0';
+    return 1;
+  }
+  const std::size_t length = (64 - std::size_t{countLeadingZeros(value)} + 3) / 4;
+  char buffer[kMaxHexChars];
+  store64(buffer, hexDigits8(value >> 32));
+  store64(buffer + 8, hexDigits8(value));
+  std::memcpy(out, buffer + kMaxHexChars - length, length);
+  return length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Rows kernels for batch parsing. A row's 16 digits can't overflow 64 bits, so the
+/// only error a row can have is an invalid character.
+inline unsigned parseRowsScalar(const char (*rows)[kBatchRowChars], std::size_t count, u64* values) {
+  unsigned invalid = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    invalid |= (parseScalar<10>(rows[i], kBatchRowChars, values[i]) != ParseError::None ? 1u : 0u) << i;
+  }
+  return invalid;
+}
+
+inline unsigned parseRowsSwar(const char (*rows)[kBatchRowChars], std::size_t count, u64* values) {
+  unsigned invalid = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    const u64 high = load64(rows[i]);
+    const u64 low = load64(rows[i] + 8);
+    invalid |= (allDecimal8(high) && allDecimal8(low) ? 0u : 1u) << i;
+    values[i] = decimal8(high) * 100000000u + decimal8(low);
+  }
+  return invalid;
+}
+
+inline unsigned matchRangeScalar(const u64* values, u64 lowest, u64 span) {
+  unsigned matches = 0;
+  for (std::size_t i = 0; i < kBatchRows; ++i) {
+    matches |= (values[i] - lowest <= span ? 1u : 0u) << i;
+  }
+  return matches;
+}
+
+inline unsigned matchMaskedScalar(const u64* values, u64 mask, u64 expected) {
+  unsigned matches = 0;
+  for (std::size_t i = 0; i < kBatchRows; ++i) {
+    matches |= ((values[i] & mask) == expected ? 1u : 0u) << i;
+  }
+  return matches;
+}
+
+#if defined(__SIZEOF_INT128__)
+
+////////////////////////////////////////////////////////////////////////////////
+/// 128-bit values go through the 64-bit kernels in pieces: 19 decimal digits, 16 hex
+/// digits or 64 binary digits at a time. A 128-bit / and % by a constant is a libgcc
+/// call costing about as much as formatting the whole piece, so the division by 10^19
+/// is done by hand, multiplying by a precomputed reciprocal (Moller and Granlund,
+/// "Improved division by invariant integers"). 10^19 already has its top bit set, so
+/// no normalizing shift is needed.
+constexpr u64 kPower19 = 10000000000000000000u;
+constexpr u64 kPower19Reciprocal = static_cast<u64>(~u128{0} / kPower19);  // Less 2^64, as it wraps
+
+/// (high * 2^64 + low) / 10^19 and its remainder, for high below 10^19.
+inline u64 divPower19(u64 high, u64 low, u64& remainder) {
+  const u128 estimate = static_cast<u128>(kPower19Reciprocal) * high + ((static_cast<u128>(high) + 1) << 64) + low;
+  u64 quotient = static_cast<u64>(estimate >> 64);
+  u64 rest = low - quotient * kPower19;
+  if (rest > static_cast<u64>(estimate)) {
+    --quotient;
+    rest += kPower19;
+  }
+  if (rest >= kPower19) {
+    ++quotient;
+    rest -= kPower19;
+  }
+  remainder = rest;
+  return quotient;
+}
+
+/// Exactly 19 digits, zero padded.
+inline void formatDecimal19(u64 value, char* out) {
+  const unsigned top = static_cast<unsigned>(value / 10000000000000000u);
+  out[0] = static_cast<char>('0' + top / 100);
+  out[1] = static_cast<char>('0' + top / 10 % 10);
+  out[2] = static_cast<char>('0' + top % 10);
+  store64(out + 3, decimalDigits8(value / 100000000u % 100000000u));
+  store64(out + 11, decimalDigits8(value % 100000000u));
+}
+
+/// The 8 bits of a byte as eight ASCII binary digits, most significant first: each
+/// output byte masks its own bit out of a copy of the input, and adding 0x7f carries
+/// into the byte's top bit exactly when the bit was set.
+inline u64 binaryDigits8(unsigned bits) {
+  const u64 picked = (kOnes * (bits & 0xffu)) & 0x0102040810204080u;
+  return (((picked + kOnes * 0x7fu) >> 7) & kOnes) + kOnes * '0';
+}
+
+/// The top byte's digits go through a word on the stack; every byte below it is
+/// stored straight to the output, most significant first.
+inline std::size_t formatBinary128Swar(u128 value, char* out) {
+  const u64 high = static_cast<u64>(value >> 64);
+  const u64 low = static_cast<u64>(value);
+  const unsigned bits = high != 0 ? 128 - countLeadingZeros(high) : low != 0 ? 64 - countLeadingZeros(low) : 1;
+  const unsigned topByte = (bits - 1) / 8;
+  const unsigned lead = bits - topByte * 8;
+  char first[8];
+  store64(first, binaryDigits8(static_cast<unsigned>(value >> (8 * topByte))));
+  std::memcpy(out, first + 8 - lead, lead);
+  char* p = out + lead;
+  for (unsigned i = topByte; i-- > 0; p += 8) {
+    store64(p, binaryDigits8(static_cast<unsigned>(i >= 8 ? high >> (8 * i - 64) : low >> (8 * i))));
+  }
+  return bits;
+}
+
+#endif  // __SIZEOF_INT128__
+
+#if SCW_INTLIT_X86_KERNELS
+
+////////////////////////////////////////////////////////////////////////////////
+/// x86 kernels. Each one converts the longest run of trailing digits it can in one
+/// go, always loading from inside the token, and hands any leading digits to the SWAR
+/// kernel. Short tokens go straight to SWAR since they don't fill a register.
+
+/// The last sixteen characters of the token, as a decimal value. Also validates.
+SCW_INTLIT_TARGET("sse4.1")
+inline bool decimal16Sse41(const char* last16, u64& value) {
+  const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(last16));
+  const __m128i valid = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                                      _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+  if (_mm_movemask_epi8(valid) != 0xffff) {
+    return false;
+  }
+  const __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+  const __m128i pairs = _mm_maddubs_epi16(digits, _mm_set_epi8(1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10));
+  const __m128i quads = _mm_madd_epi16(pairs, _mm_set_epi16(1, 100, 1, 100, 1, 100, 1, 100));
+  const __m128i packed = _mm_packus_epi32(quads, quads);
+  const __m128i octets = _mm_madd_epi16(packed, _mm_set_epi16(1, 10000, 1, 10000, 1, 10000, 1, 10000));
+  const u64 both = static_cast<u64>(_mm_cvtsi128_si64(octets));
+  value = (both & 0xffffffffu) * 100000000u + (both >> 32);
+  return true;
+}
+
+SCW_INTLIT_TARGET("sse4.1")
+inline ParseError parseDecimalSse41(const char* digits, std::size_t length, u64& value) {
+  if (length < 16) {
+    return parseDecimalSwar(digits, length, value);
+  }
+  skipLeadingZeros(digits, length);
+  if (length < 16 || length > Powers10::kDigits) {
+    return parseDecimalSwar(digits, length, value);
+  }
+
+  u64 low;
+  u64 high = 0;
+  if (!decimal16Sse41(digits + length - 16, low) ||
+      (length > 16 && parseScalar<10>(digits, length - 16, high) != ParseError::None)) {
+    return ParseError::InvalidDigit;
+  }
+  if (!Powers10::fits(high, low, 16)) {
+    return ParseError::Overflow;
+  }
+  value = high * Powers10::kPower[16] + low;
+  return ParseError::None;
+}
+
+SCW_INTLIT_TARGET("sse4.1")
+inline ParseError parseHexSse41(const char* digits, std::size_t length, u64& value) {
+  if (length < 16) {
+    return parseHexSwar(digits, length, value);
+  }
+  skipLeadingZeros(digits, length);
+  if (length != 16) {
+    return parseHexSwar(digits, length, value);
+  }
+
+  const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+  const __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+  const __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                                        _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+  const __m128i isLetter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                         _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+  if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xffff) {
+    return ParseError::InvalidDigit;
+  }
+  const __m128i nibbles = _mm_blendv_epi8(_mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)),
+                                          _mm_sub_epi8(chars, _mm_set1_epi8('0')), isDigit);
+  const __m128i pairs = _mm_maddubs_epi16(nibbles, _mm_set1_epi16(0x0110));
+  const __m128i bytes = _mm_packus_epi16(pairs, pairs);
+  value = byteSwap64(static_cast<u64>(_mm_cvtsi128_si64(bytes)));
+  return ParseError::None;
+}
+
+SCW_INTLIT_TARGET("sse4.1")
+inline ParseError parseBinarySse41(const char* digits, std::size_t length, u64& value) {
+  if (length < 16) {
+    return parseBinarySwar(digits, length, value);
+  }
+  skipLeadingZeros(digits, length);
+  if (length < 16 || length > 64) {
+    return parseBinarySwar(digits, length, value);
+  }
+
+  // Reverse the bytes so the first character lands in the top bit of the movemask
+  const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  u64 acc = 0;
+  const std::size_t head = length % 16;
+  if (head != 0 && parseBinarySwar(digits, head, acc) != ParseError::None) {
+    return ParseError::InvalidDigit;
+  }
+  for (std::size_t i = head; i < length; i += 16) {
+    const __m128i chars = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(digits + i)), reverse);
+    const __m128i ones = _mm_cmpeq_epi8(chars, _mm_set1_epi8('1'));
+    const __m128i zeros = _mm_cmpeq_epi8(chars, _mm_set1_epi8('0'));
+    if (_mm_movemask_epi8(_mm_or_si128(ones, zeros)) != 0xffff) {
+      return ParseError::InvalidDigit;
+    }
+    acc = (acc << 16) | static_cast<unsigned>(_mm_movemask_epi8(ones));
+  }
+  value = acc;
+  return ParseError::None;
+}
+
+SCW_INTLIT_TARGET("avx2")
+inline ParseError parseBinaryAvx2(const char* digits, std::size_t length, u64& value) {
+  if (length < 32) {
+    return parseBinarySse41(digits, length, value);
+  }
+  skipLeadingZeros(digits, length);
+  if (length < 32 || length > 64) {
+    return parseBinarySse41(digits, length, value);
+  }
+
+  const __m256i reverse = _mm256_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5,
+                                          6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  u64 acc = 0;
+  const std::size_t head = length % 32;
+  if (head != 0 && parseBinarySse41(digits, head, acc) != ParseError::None) {
+    return ParseError::InvalidDigit;
+  }
+  for (std::size_t i = head; i < length; i += 32) {
+    const __m256i loaded = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(digits + i));
+    const __m256i chars = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(loaded, reverse), 0x4e);
+    const __m256i ones = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('1'));
+    const __m256i zeros = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('0'));
+    if (_mm256_movemask_epi8(_mm256_or_si256(ones, zeros)) != -1) {
+      return ParseError::InvalidDigit;
+    }
+    acc = (acc << 32) | static_cast<std::uint32_t>(_mm256_movemask_epi8(ones));
+  }
+  value = acc;
+  return ParseError::None;
+}
+
+SCW_INTLIT_TARGET("avx512f,avx512bw")
+inline ParseError parseBinaryAvx512(const char* digits, std::size_t length, u64& value) {
+  if (length < 64) {
+    return parseBinaryAvx2(digits, length, value);
+  }
+  skipLeadingZeros(digits, length);
+  if (length != 64) {
+    return parseBinaryAvx2(digits, length, value);
+  }
+
+  const __m512i reverse = _mm512_set_epi64(0x0001020304050607, 0x08090a0b0c0d0e0f, 0x0001020304050607,
+                                           0x08090a0b0c0d0e0f, 0x0001020304050607, 0x08090a0b0c0d0e0f,
+                                           0x0001020304050607, 0x08090a0b0c0d0e0f);
+  const __m512i chars = _mm512_shuffle_epi8(_mm512_loadu_si512(digits), reverse);
+  const __mmask64 ones = _mm512_cmpeq_epi8_mask(chars, _mm512_set1_epi8('1'));
+  const __mmask64 zeros = _mm512_cmpeq_epi8_mask(chars, _mm512_set1_epi8('0'));
+  if ((ones | zeros) != ~__mmask64{0}) {
+    return ParseError::InvalidDigit;
+  }
+  // The shuffle reversed bytes within each 128-bit lane; swapping the mask's four
+  // 16-bit groups finishes reversing the whole register
+  const u64 bits = (static_cast<u64>(ones) << 32) | (static_cast<u64>(ones) >> 32);
+  value = ((bits & 0x0000ffff0000ffffu) << 16) | ((bits >> 16) & 0x0000ffff0000ffffu);
+  return ParseError::None;
+}
+
+SCW_INTLIT_TARGET("sse4.1")
+inline std::size_t formatHexSse41(u64 value, char* out) {
+  if (value == 0) {
+    *out = '0';
+    return 1;
+  }
+  const __m128i bytes = _mm_cvtsi64_si128(static_cast<long long>(byteSwap64(value)));
+  const __m128i mask = _mm_set1_epi8(0x0f);
+  const __m128i nibbles = _mm_unpacklo_epi8(_mm_and_si128(_mm_srli_epi16(bytes, 4), mask), _mm_and_si128(bytes, mask));
+  const __m128i ascii = _mm_shuffle_epi8(_mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b',
+                                                       'c', 'd', 'e', 'f'),
+                                         nibbles);
+  char buffer[kMaxHexChars];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), ascii);
+  const std::size_t length = (64 - std::size_t{countLeadingZeros(value)} + 3) / 4;
+  std::memcpy(out, buffer + kMaxHexChars - length, length);
+  return length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch rows, several tokens per register. Each row's digits fold into pairs and then
+/// quads on their own, the quads of two rows pack into one register, and from there
+/// every multiply-add works on both tokens' lanes at once: [high 8, low 8] of each row,
+/// then one 64-bit lane per token. A digit is valid where max(ch - '0', 9) is 9.
+SCW_INTLIT_TARGET("sse4.1")
+inline __m128i rowQuadsSse41(__m128i digits) {
+  const __m128i pairs = _mm_maddubs_epi16(digits, _mm_set_epi8(1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10));
+  return _mm_madd_epi16(pairs, _mm_set_epi16(1, 100, 1, 100, 1, 100, 1, 100));
+}
+
+SCW_INTLIT_TARGET("sse4.1")
+inline unsigned parseRowsSse41(const char (*rows)[kBatchRowChars], std::size_t count, u64* values) {
+  const __m128i zero = _mm_set1_epi8('0');
+  const __m128i nine = _mm_set1_epi8(9);
+  unsigned invalid = 0;
+  for (std::size_t i = 0; i < count; i += 2) {
+    const __m128i first = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[i])), zero);
+    const __m128i second = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[i + 1])), zero);
+    const unsigned firstValid = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(first, nine), nine)));
+    const unsigned secondValid =
+        static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(second, nine), nine)));
+    invalid |= (firstValid != 0xffff ? 1u : 0u) << i | (secondValid != 0xffff ? 2u : 0u) << i;
+
+    const __m128i quads = _mm_packus_epi32(rowQuadsSse41(first), rowQuadsSse41(second));
+    const __m128i octets = _mm_madd_epi16(quads, _mm_set_epi16(1, 10000, 1, 10000, 1, 10000, 1, 10000));
+    const __m128i both = _mm_add_epi64(_mm_mul_epu32(octets, _mm_set1_epi64x(100000000)), _mm_srli_epi64(octets, 32));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), both);
+  }
+  return invalid & ((1u << count) - 1);
+}
+
+/// Four rows per round: two per register, one in each 128-bit lane. The in-lane pack
+/// leaves the tokens in the order 0, 2, 1, 3, which one permute puts right.
+SCW_INTLIT_TARGET("avx2")
+inline __m256i rowQuadsAvx2(__m256i digits) {
+  const __m256i pairs = _mm256_maddubs_epi16(digits, _mm256_set1_epi16(0x010a));
+  return _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00010064));
+}
+
+SCW_INTLIT_TARGET("avx2")
+inline unsigned parseRowsAvx2(const char (*rows)[kBatchRowChars], std::size_t count, u64* values) {
+  const __m256i zero = _mm256_set1_epi8('0');
+  const __m256i nine = _mm256_set1_epi8(9);
+  unsigned invalid = 0;
+  for (std::size_t i = 0; i < count; i += 4) {
+    const __m256i first = _mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[i])), zero);
+    const __m256i second = _mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[i + 2])), zero);
+    const unsigned firstValid =
+        static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(first, nine), nine)));
+    const unsigned secondValid =
+        static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(second, nine), nine)));
+    invalid |= ((firstValid & 0xffff) != 0xffff ? 1u : 0u) << i | (firstValid >> 16 != 0xffff ? 2u : 0u) << i |
+               ((secondValid & 0xffff) != 0xffff ? 4u : 0u) << i | (secondValid >> 16 != 0xffff ? 8u : 0u) << i;
+
+    const __m256i quads = _mm256_packus_epi32(rowQuadsAvx2(first), rowQuadsAvx2(second));
+    const __m256i octets = _mm256_madd_epi16(quads, _mm256_set1_epi32(0x00012710));
+    const __m256i both =
+        _mm256_add_epi64(_mm256_mul_epu32(octets, _mm256_set1_epi64x(100000000)), _mm256_srli_epi64(octets, 32));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), _mm256_permute4x64_epi64(both, 0xd8));
+  }
+  return invalid & ((1u << count) - 1);
+}
+
+/// AVX2 only compares signed 64-bit lanes, so the range test flips both sides' sign
+/// bits to get the unsigned order.
+SCW_INTLIT_TARGET("avx2")
+inline unsigned matchRangeAvx2(const u64* values, u64 lowest, u64 span) {
+  const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(u64{1} << 63));
+  const __m256i low = _mm256_set1_epi64x(static_cast<long long>(lowest));
+  const __m256i high = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(span)), sign);
+  unsigned outside = 0;
+  for (std::size_t i = 0; i < kBatchRows; i += 4) {
+    const __m256i offset = _mm256_sub_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)), low);
+    const __m256i above = _mm256_cmpgt_epi64(_mm256_xor_si256(offset, sign), high);
+    outside |= static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(above))) << i;
+  }
+  return ~outside & 0xffff;
+}
+
+SCW_INTLIT_TARGET("avx2")
+inline unsigned matchMaskedAvx2(const u64* values, u64 mask, u64 expected) {
+  const __m256i bits = _mm256_set1_epi64x(static_cast<long long>(mask));
+  const __m256i wanted = _mm256_set1_epi64x(static_cast<long long>(expected));
+  unsigned matches = 0;
+  for (std::size_t i = 0; i < kBatchRows; i += 4) {
+    const __m256i masked = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)), bits);
+    const __m256i equal = _mm256_cmpeq_epi64(masked, wanted);
+    matches |= static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(equal))) << i;
+  }
+  return matches;
+}
+
+SCW_INTLIT_TARGET("avx512f")
+inline unsigned matchRangeAvx512(const u64* values, u64 lowest, u64 span) {
+  const __m512i low = _mm512_set1_epi64(static_cast<long long>(lowest));
+  const __m512i high = _mm512_set1_epi64(static_cast<long long>(span));
+  const __m512i first = _mm512_sub_epi64(_mm512_loadu_si512(values), low);
+  const __m512i second = _mm512_sub_epi64(_mm512_loadu_si512(values + 8), low);
+  return static_cast<unsigned>(_mm512_cmple_epu64_mask(first, high)) |
+         static_cast<unsigned>(_mm512_cmple_epu64_mask(second, high)) << 8;
+}
+
+SCW_INTLIT_TARGET("avx512f")
+inline unsigned matchMaskedAvx512(const u64* values, u64 mask, u64 expected) {
+  const __m512i bits = _mm512_set1_epi64(static_cast<long long>(mask));
+  const __m512i wanted = _mm512_set1_epi64(static_cast<long long>(expected));
+  const __m512i first = _mm512_and_si512(_mm512_loadu_si512(values), bits);
+  const __m512i second = _mm512_and_si512(_mm512_loadu_si512(values + 8), bits);
+  return static_cast<unsigned>(_mm512_cmpeq_epi64_mask(first, wanted)) |
+         static_cast<unsigned>(_mm512_cmpeq_epi64_mask(second, wanted)) << 8;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Dotted quads. The dots' movemask gives the four octet lengths, which pick one of
+/// 81 shuffles that line each octet's digits up as [0, hundreds, tens, units] in its
+/// own 32-bit lane; one multiply-add pass then converts all four at once. Anything
+/// the fast path doesn't like goes back to the scalar kernel, which reports the error.
+constexpr unsigned ipv4OctetLength(unsigned row, unsigned octet) {
+  return (octet == 0 ? row : octet == 1 ? row / 3 : octet == 2 ? row / 9 : row / 27) % 3 + 1;
+}
+
+constexpr unsigned ipv4OctetStart(unsigned row, unsigned octet) {
+  return octet == 0 ? 0 : ipv4OctetStart(row, octet - 1) + ipv4OctetLength(row, octet - 1) + 1;
+}
+
+constexpr std::uint8_t ipv4ShuffleByte(unsigned row, unsigned lane, unsigned slot, unsigned length) {
+  return slot == 0 || slot + length < 4 ? 0x80 :
+                                          static_cast<std::uint8_t>(ipv4OctetStart(row, lane) + slot + length - 4);
+}
+
+constexpr std::uint8_t ipv4ShuffleByte(unsigned row, unsigned index) {
+  return ipv4ShuffleByte(row, index / 4, index % 4, ipv4OctetLength(row, index / 4));
+}
+
+struct Ipv4ShuffleRow {
+  std::uint8_t index[16];
+};
+
+constexpr Ipv4ShuffleRow ipv4ShuffleRow(unsigned row) {
+  return Ipv4ShuffleRow{{ipv4ShuffleByte(row, 0), ipv4ShuffleByte(row, 1), ipv4ShuffleByte(row, 2),
+                         ipv4ShuffleByte(row, 3), ipv4ShuffleByte(row, 4), ipv4ShuffleByte(row, 5),
+                         ipv4ShuffleByte(row, 6), ipv4ShuffleByte(row, 7), ipv4ShuffleByte(row, 8),
+                         ipv4ShuffleByte(row, 9), ipv4ShuffleByte(row, 10), ipv4ShuffleByte(row, 11),
+                         ipv4ShuffleByte(row, 12), ipv4ShuffleByte(row, 13), ipv4ShuffleByte(row, 14),
+                         ipv4ShuffleByte(row, 15)}};
+}
+
+template <typename Indices>
+struct Ipv4ShuffleTable;
+
+template <unsigned... kIndex>
+struct Ipv4ShuffleTable<intliterals::detail::IndexList<kIndex...>> {
+  static constexpr Ipv4ShuffleRow kRows[] = {ipv4ShuffleRow(kIndex)...};
+};
+
+#if !defined(__cpp_inline_variables) || __cpp_inline_variables < 201606L
+template <unsigned... kIndex>
+constexpr Ipv4ShuffleRow Ipv4ShuffleTable<intliterals::detail::IndexList<kIndex...>>::kRows[];
+#endif
+
+using Ipv4Shuffles = Ipv4ShuffleTable<intliterals::detail::MakeIndexList<81>::type>;
+
+SCW_INTLIT_TARGET("sse4.1")
+inline ParseError parseIpv4Sse41(const char* text, std::size_t length, std::uint32_t& address) {
+  if (length < 7 || length > kMaxIpv4Chars) {
+    return parseIpv4Scalar(text, length, address);
+  }
+  char buffer[16] = {};
+  std::memcpy(buffer, text, length);
+  const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer));
+  const __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+  const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+  const unsigned inside = (1u << length) - 1;
+  const unsigned digitBits = static_cast<unsigned>(_mm_movemask_epi8(isDigit)) & inside;
+  const unsigned dotBits = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('.')))) & inside;
+  const unsigned zeroBits = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('0'))));
+  if ((digitBits | dotBits) != inside || __builtin_popcount(dotBits) != 3 ||
+      ((1u | dotBits << 1) & zeroBits & digitBits >> 1) != 0) {
+    return parseIpv4Scalar(text, length, address);  // Not four dotted numbers, or a leading zero
+  }
+
+  const unsigned dot1 = countTrailingZeros(dotBits);
+  const unsigned dot2 = countTrailingZeros(dotBits & (dotBits - 1));
+  const unsigned dot3 = 63 - countLeadingZeros(dotBits);
+  const unsigned length1 = dot1 - 1;
+  const unsigned length2 = dot2 - dot1 - 2;
+  const unsigned length3 = dot3 - dot2 - 2;
+  const unsigned length4 = static_cast<unsigned>(length) - dot3 - 2;
+  if (length1 > 2 || length2 > 2 || length3 > 2 || length4 > 2) {
+    return parseIpv4Scalar(text, length, address);  // An empty or four digit octet
+  }
+
+  const Ipv4ShuffleRow& row = Ipv4Shuffles::kRows[length1 + 3 * length2 + 9 * length3 + 27 * length4];
+  const __m128i lined = _mm_shuffle_epi8(digits, _mm_loadu_si128(reinterpret_cast<const __m128i*>(row.index)));
+  const __m128i octets = _mm_madd_epi16(
+      _mm_maddubs_epi16(lined, _mm_setr_epi8(0, 100, 10, 1, 0, 100, 10, 1, 0, 100, 10, 1, 0, 100, 10, 1)),
+      _mm_set1_epi16(1));
+  if (_mm_movemask_epi8(_mm_cmpgt_epi32(octets, _mm_set1_epi32(255))) != 0) {
+    return ParseError::Overflow;
+  }
+  const __m128i words = _mm_packus_epi32(octets, octets);
+  address = static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(words, words)));
+  return ParseError::None;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// IPv6 text. Three registers classify the whole address and turn every hex digit
+/// into its nibble; the colons' movemask then splits it into hextets, each combined
+/// from one four byte load. Dotted tails and anything malformed go to the scalar kernel.
+inline unsigned hextet(const char* nibbles, std::size_t width) {
+  // Right align the nibbles, then pair them into bytes and the bytes into the value
+  const std::uint32_t word = static_cast<std::uint32_t>(load32(nibbles) << (32 - 8 * width));
+  const std::uint32_t pairs = ((word << 4) | (word >> 8)) & 0x00ff00ffu;
+  return ((pairs & 0xffu) << 8) | (pairs >> 16);
+}
+
+SCW_INTLIT_TARGET("sse4.1")
+inline ParseError parseIpv6Sse41(const char* text, std::size_t length, Ipv6Address& address) {
+  const std::size_t kNoGap = ~std::size_t{0};
+  const std::size_t kMaxHexText = 39;
+  if (length < 2 || length > kMaxHexText || (text[0] == ':' && text[1] != ':')) {
+    return parseIpv6Scalar(text, length, address);
+  }
+  char buffer[48] = {};
+  char nibbles[48] = {};  // hextet() loads four bytes, past the last 16 byte store for a short final hextet
+  std::memcpy(buffer, text, length);
+  u64 hexBits = 0;
+  u64 colonBits = 0;
+  for (std::size_t i = 0; i < length; i += 16) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + i));
+    const __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i letters = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+    const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letters, _mm_set1_epi8(5)), letters);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(nibbles + i),
+                     _mm_blendv_epi8(_mm_add_epi8(letters, _mm_set1_epi8(10)), digits, isDigit));
+    hexBits |= u64{static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)))} << i;
+    colonBits |= u64{static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8(':'))))} << i;
+  }
+  const u64 inside = (u64{1} << length) - 1;
+  colonBits &= inside;
+  if (((hexBits | colonBits) & inside) != inside) {
+    return parseIpv6Scalar(text, length, address);
+  }
+
+  std::uint16_t words[8];
+  std::size_t count = 0;
+  std::size_t gap = kNoGap;
+  bool afterGap = false;
+  for (std::size_t at = text[0] == ':' ? 1 : 0;;) {
+    const u64 rest = colonBits >> at;
+    const std::size_t end = rest != 0 ? at + countTrailingZeros(rest) : length;
+    const std::size_t width = end - at;
+    if (width == 0) {
+      if (end == length) {
+        if (!afterGap) {
+          return parseIpv6Scalar(text, length, address);  // A single trailing colon
+        }
+        break;
+      }
+      if (gap != kNoGap) {
+        return parseIpv6Scalar(text, length, address);  // A second "::"
+      }
+      gap = count;
+      afterGap = true;
+    } else {
+      if (width > 4 || count == 8) {
+        return parseIpv6Scalar(text, length, address);
+      }
+      words[count++] = static_cast<std::uint16_t>(hextet(nibbles + at, width));
+      afterGap = false;
+      if (end == length) {
+        break;
+      }
+    }
+    at = end + 1;
+  }
+  return finishIpv6(words, count, gap, address) ? ParseError::None : parseIpv6Scalar(text, length, address);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// UUIDs. Three overlapping loads cover the 36 characters; shuffles drop the hyphens
+/// and gather the 32 digits into two registers in text order, which convert to the
+/// sixteen bytes with one multiply-add and one pack. Formatting runs the same shuffles
+/// backwards.
+SCW_INTLIT_TARGET("sse4.1")
+inline ParseError parseUuidSse41(const char* text, std::size_t length, Uuid& uuid) {
+  if (length != kUuidChars) {
+    return parseUuidScalar(text, length, uuid);
+  }
+  const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text));
+  const __m128i middle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 16));
+  const __m128i last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 20));
+  const __m128i hyphen = _mm_set1_epi8('-');
+  const unsigned hyphens = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(first, hyphen))) & 0x2100u;
+  const unsigned hyphens2 = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(middle, hyphen))) & 0x0084u;
+  if (hyphens != 0x2100u || hyphens2 != 0x0084u) {
+    return ParseError::InvalidDigit;
+  }
+
+  const __m128i head = _mm_or_si128(
+      _mm_shuffle_epi8(first, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 14, 15, -128, -128)),
+      _mm_shuffle_epi8(middle, _mm_setr_epi8(-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128,
+                                             -128, -128, 0, 1)));
+  const __m128i tail = _mm_or_si128(
+      _mm_shuffle_epi8(middle, _mm_setr_epi8(3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15, -128, -128, -128, -128)),
+      _mm_shuffle_epi8(last, _mm_setr_epi8(-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128,
+                                           12, 13, 14, 15)));
+
+  __m128i halves[2] = {head, tail};
+  for (__m128i& chars : halves) {
+    const __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i letters = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+    const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letters, _mm_set1_epi8(5)), letters);
+    if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xffff) {
+      return ParseError::InvalidDigit;
+    }
+    const __m128i nibbles = _mm_blendv_epi8(_mm_add_epi8(letters, _mm_set1_epi8(10)), digits, isDigit);
+    chars = _mm_maddubs_epi16(nibbles, _mm_set1_epi16(0x0110));
+  }
+  const __m128i bytes = _mm_packus_epi16(halves[0], halves[1]);
+  uuid.high = byteSwap64(static_cast<u64>(_mm_cvtsi128_si64(bytes)));
+  uuid.low = byteSwap64(static_cast<u64>(_mm_extract_epi64(bytes, 1)));
+  return ParseError::None;
+}
+
+SCW_INTLIT_TARGET("sse4.1")
+inline void formatUuidSse41(const Uuid& uuid, char* out) {
+  const __m128i bytes = _mm_set_epi64x(static_cast<long long>(byteSwap64(uuid.low)),
+                                       static_cast<long long>(byteSwap64(uuid.high)));
+  const __m128i mask = _mm_set1_epi8(0x0f);
+  const __m128i highNibbles = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+  const __m128i lowNibbles = _mm_and_si128(bytes, mask);
+  const __m128i hexDigits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+  const __m128i head = _mm_shuffle_epi8(hexDigits, _mm_unpacklo_epi8(highNibbles, lowNibbles));
+  const __m128i tail = _mm_shuffle_epi8(hexDigits, _mm_unpackhi_epi8(highNibbles, lowNibbles));
+
+  // The tail goes in first at 20, so its last four digits land at 32; the middle
+  // sixteen characters then overwrite the rest of it
+  char buffer[kUuidChars];
+  const __m128i first = _mm_or_si128(
+      _mm_shuffle_epi8(head, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, -128, 8, 9, 10, 11, -128, 12, 13)),
+      _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, '-', 0, 0, 0, 0, '-', 0, 0));
+  const __m128i middle = _mm_or_si128(
+      _mm_or_si128(_mm_shuffle_epi8(head, _mm_setr_epi8(14, 15, -128, -128, -128, -128, -128, -128, -128, -128, -128,
+                                                        -128, -128, -128, -128, -128)),
+                   _mm_shuffle_epi8(tail, _mm_setr_epi8(-128, -128, -128, 0, 1, 2, 3, -128, 4, 5, 6, 7, 8, 9, 10, 11))),
+      _mm_setr_epi8(0, 0, '-', 0, 0, 0, 0, '-', 0, 0, 0, 0, 0, 0, 0, 0));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer + 20), tail);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), first);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer + 16), middle);
+  std::memcpy(out, buffer, kUuidChars);
+}
+
+#endif  // SCW_INTLIT_X86_KERNELS
+
+}  // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////
+/// The kernels picked for each operation, and the tier each one came from.
+struct KernelTable {
+  ParseKernel parseDecimal;
+  ParseKernel parseHex;
+  ParseKernel parseBinary;
+  FormatKernel formatDecimal;
+  FormatKernel formatHex;
+  Ipv4ParseKernel parseIpv4;
+  Ipv6ParseKernel parseIpv6;
+  UuidParseKernel parseUuid;
+  UuidFormatKernel formatUuid;
+  RowsParseKernel parseDecimalRows;
+  RowsRangeKernel matchRange;
+  RowsMaskedKernel matchMasked;
+  Isa isa[kKernelOpCount];
+  Isa detected;  // Best tier the CPU supports
+  Isa limit;     // Tier the table was resolved for
+};
+
+namespace detail {
+
+template <typename Kernel>
+struct Candidate {
+  Isa isa;
+  Kernel kernel;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Candidates are listed best first; the first one at or below the table's limit wins.
+/// The last candidate is always scalar, so there is always a pick.
+template <typename Kernel, std::size_t kCount>
+Kernel pickKernel(const Candidate<Kernel> (&candidates)[kCount], KernelTable& table, KernelOp op) {
+  std::size_t i = 0;
+  while (i + 1 < kCount && candidates[i].isa > table.limit) {
+    ++i;
+  }
+  table.isa[static_cast<std::size_t>(op)] = candidates[i].isa;
+  return candidates[i].kernel;
+}
+
+}  // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////
+/// Highest tier this CPU (and OS, for the wide registers) supports.
+inline Isa detectIsa() {
+#if SCW_INTLIT_X86_KERNELS
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+    return Isa::Avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return Isa::Avx2;
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    return Isa::Sse41;
+  }
+#endif
+  return Isa::Swar;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Parses an ISA name as used by SCW_INTLIT_ISA. Returns false for unknown names.
+inline bool isaFromName(const char* name, Isa& isa) {
+  const Isa all[] = {Isa::Scalar, Isa::Swar, Isa::Sse41, Isa::Avx2, Isa::Avx512};
+  for (Isa candidate : all) {
+    if (name != nullptr && std::strcmp(name, isaName(candidate)) == 0) {
+      isa = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Builds a kernel table using nothing above limit or above what the CPU supports.
+/// The active table comes from here, and tests and benchmarks use it to pin a tier.
+inline KernelTable resolveKernels(Isa limit) {
+  KernelTable table;
+  table.detected = detectIsa();
+  table.limit = limit < table.detected ? limit : table.detected;
+
+  using ParseCandidate = detail::Candidate<ParseKernel>;
+  using FormatCandidate = detail::Candidate<FormatKernel>;
+  const ParseCandidate decimal[] = {
+#if SCW_INTLIT_X86_KERNELS
+      {Isa::Sse41, detail::parseDecimalSse41},
+#endif
+      {Isa::Swar, detail::parseDecimalSwar},
+      {Isa::Scalar, detail::parseScalar<10>},
+  };
+  const ParseCandidate hex[] = {
+#if SCW_INTLIT_X86_KERNELS
+      {Isa::Sse41, detail::parseHexSse41},
+#endif
+      {Isa::Swar, detail::parseHexSwar},
+      {Isa::Scalar, detail::parseScalar<16>},
+  };
+  const ParseCandidate binary[] = {
+#if SCW_INTLIT_X86_KERNELS
+      {Isa::Avx512, detail::parseBinaryAvx512},
+      {Isa::Avx2, detail::parseBinaryAvx2},
+      {Isa::Sse41, detail::parseBinarySse41},
+#endif
+      {Isa::Swar, detail::parseBinarySwar},
+      {Isa::Scalar, detail::parseScalar<2>},
+  };
+  const FormatCandidate formatDecimal[] = {
+      {Isa::Swar, detail::formatDecimalSwar},
+      {Isa::Scalar, detail::formatDecimalScalar},
+  };
+  const FormatCandidate formatHex[] = {
+#if SCW_INTLIT_X86_KERNELS
+      {Isa::Sse41, detail::formatHexSse41},
+#endif
+      {Isa::Swar, detail::formatHexSwar},
+      {Isa::Scalar, detail::formatHexScalar},
+  };
+  const detail::Candidate<Ipv4ParseKernel> ipv4[] = {
+#if SCW_INTLIT_X86_KERNELS
+      {Isa::Sse41, detail::parseIpv4Sse41},
+#endif
+      {Isa::Scalar, detail::parseIpv4Scalar},
+  };
+  const detail::Candidate<Ipv6ParseKernel> ipv6[] = {
+#if SCW_INTLIT_X86_KERNELS
+      {Isa::Sse41, detail::parseIpv6Sse41},
+#endif
+      {Isa::Scalar, detail::parseIpv6Scalar},
+  };
+  const detail::Candidate<UuidParseKernel> uuid[] = {
+#if SCW_INTLIT_X86_KERNELS
+      {Isa::Sse41, detail::parseUuidSse41},
+#endif
+      {Isa::Scalar, detail::parseUuidScalar},
+  };
+  const detail::Candidate<UuidFormatKernel> formatUuid[] = {
+#if SCW_INTLIT_X86_KERNELS
+      {Isa::Sse41, detail::formatUuidSse41},
+#endif
+      {Isa::Scalar, detail::formatUuidScalar},
+  };
+  const detail::Candidate<RowsParseKernel> decimalRows[] = {
+#if SCW_INTLIT_X86_KERNELS
+      {Isa::Avx2, detail::parseRowsAvx2},
+      {Isa::Sse41, detail::parseRowsSse41},
+#endif
+      {Isa::Swar, detail::parseRowsSwar},
+      {Isa::Scalar, detail::parseRowsScalar},
+  };
+  const detail::Candidate<RowsRangeKernel> matchRange[] = {
+#if SCW_INTLIT_X86_KERNELS
+      {Isa::Avx512, detail::matchRangeAvx512},
+      {Isa::Avx2, detail::matchRangeAvx2},
+#endif
+      {Isa::Scalar, detail::matchRangeScalar},
+  };
+  const detail::Candidate<RowsMaskedKernel> matchMasked[] = {
+#if SCW_INTLIT_X86_KERNELS
+      {Isa::Avx512, detail::matchMaskedAvx512},
+      {Isa::Avx2, detail::matchMaskedAvx2},
+#endif
+      {Isa::Scalar, detail::matchMaskedScalar},
+  };
+
+  table.parseDecimal = detail::pickKernel(decimal, table, KernelOp::ParseDecimal);
+  table.parseHex = detail::pickKernel(hex, table, KernelOp::ParseHex);
+  table.parseBinary = detail::pickKernel(binary, table, KernelOp::ParseBinary);
+  table.formatDecimal = detail::pickKernel(formatDecimal, table, KernelOp::FormatDecimal);
+  table.formatHex = detail::pickKernel(formatHex, table, KernelOp::FormatHex);
+  table.parseIpv4 = detail::pickKernel(ipv4, table, KernelOp::ParseIpv4);
+  table.parseIpv6 = detail::pickKernel(ipv6, table, KernelOp::ParseIpv6);
+  table.parseUuid = detail::pickKernel(uuid, table, KernelOp::ParseUuid);
+  table.formatUuid = detail::pickKernel(formatUuid, table, KernelOp::FormatUuid);
+  table.parseDecimalRows = detail::pickKernel(decimalRows, table, KernelOp::ParseDecimalBatch);
+  table.matchRange = detail::pickKernel(matchRange, table, KernelOp::MatchRows);
+  table.matchMasked = detail::pickKernel(matchMasked, table, KernelOp::MatchRows);
+  return table;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The table every dispatched call goes through. Resolved once, on first use, from
+/// cpuid and the SCW_INTLIT_ISA override.
+inline const KernelTable& activeKernels() {
+  static const KernelTable table = [] {
+    Isa limit = Isa::Avx512;
+    isaFromName(std::getenv("SCW_INTLIT_ISA"), limit);
+    return resolveKernels(limit);
+  }();
+  return table;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Introspection: which tier is running an operation in this process.
+inline Isa activeKernelIsa(KernelOp op) {
+  return activeKernels().isa[static_cast<std::size_t>(op)];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Statistics. Counting is compiled out entirely unless SCW_FIXEDWIDTH_INT_LITERALS_STATS
+/// is defined; statsSnapshot() still exists either way and reports zeros when off.
+///
+/// Each thread counts into its own cache-line aligned block with plain relaxed loads
+/// and stores, so the hot path never takes a lock or a locked instruction. Blocks
+/// live on a lock-free list that snapshots walk with relaxed loads; a snapshot may be
+/// a few counts behind a busy thread but never stalls it. A thread's block is handed
+/// to the next new thread when it exits, so counts are never lost.
+#if defined(SCW_FIXEDWIDTH_INT_LITERALS_STATS)
+constexpr bool kStatsEnabled = true;
+#else
+constexpr bool kStatsEnabled = false;
+#endif
+
+constexpr std::size_t kParseErrorCount = 4;
+constexpr std::size_t kIsaCount = 5;
+
+struct StatsSnapshot {
+  u64 valuesParsed = 0;
+  u64 bytesConsumed = 0;
+  u64 valuesFormatted = 0;
+  u64 bytesFormatted = 0;
+  u64 errors[kParseErrorCount] = {};  // Indexed by ParseError; None stays zero
+  u64 kernelCalls[kIsaCount] = {};    // Indexed by the Isa of the kernel that ran
+  u64 cacheHits = 0;                  // Dictionary codes found, and kernel tables a ParseContext held
+  u64 threads = 0;                    // Per-thread blocks created; blocks of exited threads are reused
+
+  /// Counts accumulated since an earlier snapshot.
+  StatsSnapshot since(const StatsSnapshot& earlier) const {
+    StatsSnapshot delta = *this;
+    delta.valuesParsed -= earlier.valuesParsed;
+    delta.bytesConsumed -= earlier.bytesConsumed;
+    delta.valuesFormatted -= earlier.valuesFormatted;
+    delta.bytesFormatted -= earlier.bytesFormatted;
+    for (std::size_t i = 0; i < kParseErrorCount; ++i) {
+      delta.errors[i] -= earlier.errors[i];
+    }
+    for (std::size_t i = 0; i < kIsaCount; ++i) {
+      delta.kernelCalls[i] -= earlier.kernelCalls[i];
+    }
+    delta.cacheHits -= earlier.cacheHits;
+    delta.threads -= earlier.threads;
+    return delta;
+  }
+};
+
+namespace detail {
+
+#if defined(SCW_FIXEDWIDTH_INT_LITERALS_STATS)
+
+constexpr std::size_t kCacheLine = 64;
+
+enum StatsCounter : std::size_t {
+  kValuesParsed,
+  kBytesConsumed,
+  kValuesFormatted,
+  kBytesFormatted,
+  kErrors,
+  kKernelCalls = kErrors + kParseErrorCount,
+  kCacheHits = kKernelCalls + kIsaCount,
+  kStatsCounterCount,
+};
+
+struct alignas(kCacheLine) StatsBlock {
+  std::atomic<u64> counters[kStatsCounterCount];
+  std::atomic<bool> inUse;
+  StatsBlock* next;
+};
+
+inline std::atomic<StatsBlock*>& statsHead() {
+  static std::atomic<StatsBlock*> head{nullptr};
+  return head;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reuses the block of a thread that has exited, or links in a new one. Blocks are
+/// never freed, so snapshots can walk the list without coordination.
+inline StatsBlock* acquireStatsBlock() {
+  std::atomic<StatsBlock*>& head = statsHead();
+  for (StatsBlock* block = head.load(std::memory_order_acquire); block != nullptr; block = block->next) {
+    bool expected = false;
+    if (block->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+      return block;
+    }
+  }
+
+  // Over-aligned new only arrived in C++17, so align by hand
+  void* raw = ::operator new(sizeof(StatsBlock) + kCacheLine);
+  void* aligned = reinterpret_cast<void*>((reinterpret_cast<std::uintptr_t>(raw) + kCacheLine - 1) &
+                                          ~std::uintptr_t{kCacheLine - 1});
+  StatsBlock* block = new (aligned) StatsBlock;
+  for (std::atomic<u64>& counter : block->counters) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+  block->inUse.store(true, std::memory_order_relaxed);
+  block->next = head.load(std::memory_order_relaxed);
+  while (!head.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed)) {
+  }
+  return block;
+}
+
+struct StatsHandle {
+  StatsBlock* block = acquireStatsBlock();
+  ~StatsHandle() { block->inUse.store(false, std::memory_order_release); }
+};
+
+inline StatsBlock& threadStats() {
+  static thread_local StatsHandle handle;
+  return *handle.block;
+}
+
+/// Only the owning thread writes a block, so a relaxed load and store is enough.
+inline void bump(StatsBlock& block, std::size_t counter, u64 amount) {
+  std::atomic<u64>& slot = block.counters[counter];
+  slot.store(slot.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+inline void recordParse(Isa isa, std::size_t length, ParseError error) {
+  StatsBlock& block = threadStats();
+  bump(block, error == ParseError::None ? kValuesParsed : kErrors + static_cast<std::size_t>(error), 1);
+  bump(block, kBytesConsumed, length);
+  bump(block, kKernelCalls + static_cast<std::size_t>(isa), 1);
+}
+
+inline void recordFormat(Isa isa, std::size_t length) {
+  StatsBlock& block = threadStats();
+  bump(block, kValuesFormatted, 1);
+  bump(block, kBytesFormatted, length);
+  bump(block, kKernelCalls + static_cast<std::size_t>(isa), 1);
+}
+
+inline void recordCacheHits(u64 hits) {
+  bump(threadStats(), kCacheHits, hits);
+}
+
+#else
+
+inline void recordParse(Isa, std::size_t, ParseError) {}
+inline void recordFormat(Isa, std::size_t) {}
+inline void recordCacheHits(u64) {}
+
+#endif  // SCW_FIXEDWIDTH_INT_LITERALS_STATS
+
+}  // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sums every thread's counters. Safe to call from any thread at any time.
+inline StatsSnapshot statsSnapshot() {
+  StatsSnapshot snapshot;
+#if defined(SCW_FIXEDWIDTH_INT_LITERALS_STATS)
+  using namespace detail;
+  for (StatsBlock* block = statsHead().load(std::memory_order_acquire); block != nullptr; block = block->next) {
+    const auto read = [block](std::size_t counter) { return block->counters[counter].load(std::memory_order_relaxed); };
+    snapshot.valuesParsed += read(kValuesParsed);
+    snapshot.bytesConsumed += read(kBytesConsumed);
+    snapshot.valuesFormatted += read(kValuesFormatted);
+    snapshot.bytesFormatted += read(kBytesFormatted);
+    for (std::size_t i = 0; i < kParseErrorCount; ++i) {
+      snapshot.errors[i] += read(kErrors + i);
+    }
+    for (std::size_t i = 0; i < kIsaCount; ++i) {
+      snapshot.kernelCalls[i] += read(kKernelCalls + i);
+    }
+    snapshot.cacheHits += read(kCacheHits);
+    ++snapshot.threads;
+  }
+#endif
+  return snapshot;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The dispatched entry points.
+inline ParseError parseDecimal(const char* digits, std::size_t length, u64& value) {
+  const KernelTable& table = activeKernels();
+  const ParseError error = table.parseDecimal(digits, length, value);
+  detail::recordParse(table.isa[static_cast<std::size_t>(KernelOp::ParseDecimal)], length, error);
+  return error;
+}
+
+inline ParseError parseHex(const char* digits, std::size_t length, u64& value) {
+  const KernelTable& table = activeKernels();
+  const ParseError error = table.parseHex(digits, length, value);
+  detail::recordParse(table.isa[static_cast<std::size_t>(KernelOp::ParseHex)], length, error);
+  return error;
+}
+
+inline ParseError parseBinary(const char* digits, std::size_t length, u64& value) {
+  const KernelTable& table = activeKernels();
+  const ParseError error = table.parseBinary(digits, length, value);
+  detail::recordParse(table.isa[static_cast<std::size_t>(KernelOp::ParseBinary)], length, error);
+  return error;
+}
+
+/// Any radix the literal grammar supports. Octal is rare enough to stay scalar.
+inline ParseError parseRadix(const char* digits, std::size_t length, unsigned radix, u64& value) {
+  switch (radix) {
+    case 2: return parseBinary(digits, length, value);
+    case 16: return parseHex(digits, length, value);
+    case 8: {
+      const ParseError error = detail::parseScalar<8>(digits, length, value);
+      detail::recordParse(Isa::Scalar, length, error);
+      return error;
+    }
+    default: return parseDecimal(digits, length, value);
+  }
+}
+
+/// Writes the digits without a terminator and returns how many were written.
+inline std::size_t formatDecimal(u64 value, char* out) {
+  const KernelTable& table = activeKernels();
+  const std::size_t length = table.formatDecimal(value, out);
+  detail::recordFormat(table.isa[static_cast<std::size_t>(KernelOp::FormatDecimal)], length);
+  return length;
+}
+
+inline std::size_t formatHex(u64 value, char* out) {
+  const KernelTable& table = activeKernels();
+  const std::size_t length = table.formatHex(value, out);
+  detail::recordFormat(table.isa[static_cast<std::size_t>(KernelOp::FormatHex)], length);
+  return length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Many short decimal tokens at once, each into values[i] as a T, with its error in
+/// errors[i] and a zero value where there was one. Text is anything with data() and
+/// size(), such as std::string_view. The bound is numeric_limits<T>::max(), the same
+/// one checkValid_* holds literals to, and as everywhere else there's no sign. Returns
+/// how many tokens parsed cleanly.
+///
+/// Tokens of up to 16 digits go through the rows kernel kBatchRows at a time; longer
+/// ones, which are rare in the columns this is meant for, go one by one.
+namespace detail {
+
+/// A token of 1 to 16 characters as the two words of its row, '0' padded on the left.
+/// Overlapping fixed size loads stand in for a variable length copy.
+inline void copyRightAligned(char* row, const char* text, std::size_t length) {
+  const u64 zeros = kOnes * '0';
+  u64 high = zeros;
+  u64 low;
+  if (length > 8) {
+    const unsigned pad = static_cast<unsigned>(8 * (kBatchRowChars - length));
+    high = load64(text) << pad | (zeros & ((u64{1} << pad) - 1));
+    low = load64(text + length - 8);
+  } else {
+    u64 word;
+    if (length >= 4) {
+      word = load32(text) | load32(text + length - 4) << (8 * (length - 4));
+    } else {
+      word = static_cast<u64>(static_cast<unsigned char>(text[0])) |
+             static_cast<u64>(static_cast<unsigned char>(text[length / 2])) << (8 * (length / 2)) |
+             static_cast<u64>(static_cast<unsigned char>(text[length - 1])) << (8 * (length - 1));
+    }
+    const unsigned pad = static_cast<unsigned>(8 * (8 - length));
+    low = word << pad | (zeros & ((u64{1} << pad) - 1));
+  }
+  store64(row, high);
+  store64(row + 8, low);
+}
+
+/// Up to kBatchRows tokens, their rows, and once converted each one's value and error.
+struct DecimalBlock {
+  alignas(32) char rows[kBatchRows][kBatchRowChars];
+  u64 values[kBatchRows];
+  ParseError errors[kBatchRows];
+  const char* texts[kBatchRows];
+  std::size_t lengths[kBatchRows];
+  std::size_t count;
+  unsigned overlong;  // Rows whose token goes one by one
+};
+
+inline void addToBlock(DecimalBlock& block, const char* text, std::size_t length) {
+  const std::size_t i = block.count++;
+  block.texts[i] = text;
+  block.lengths[i] = length;
+  if (length - 1 < kBatchRowChars) {
+    copyRightAligned(block.rows[i], text, length);
+  } else {
+    std::memset(block.rows[i], '0', kBatchRowChars);
+    block.overlong |= 1u << i;
+  }
+}
+
+/// Runs the rows kernel over the block, then holds each value to bound.
+inline void convertBlock(const KernelTable& table, DecimalBlock& block, u64 bound) {
+  for (std::size_t i = block.count; i < ((block.count + 3) & ~std::size_t{3}); ++i) {
+    std::memset(block.rows[i], '0', kBatchRowChars);
+  }
+  const unsigned invalid = table.parseDecimalRows(block.rows, block.count, block.values);
+  const Isa isa = table.isa[static_cast<std::size_t>(KernelOp::ParseDecimalBatch)];
+  for (std::size_t i = 0; i < block.count; ++i) {
+    ParseError error = (invalid >> i & 1) != 0 ? ParseError::InvalidDigit : ParseError::None;
+    if ((block.overlong >> i & 1) != 0) {
+      error = table.parseDecimal(block.texts[i], block.lengths[i], block.values[i]);
+    }
+    if (error == ParseError::None && block.values[i] > bound) {
+      error = ParseError::Overflow;
+    }
+    block.errors[i] = error;
+    recordParse(isa, block.lengths[i], error);
+  }
+}
+
+template <typename T, typename Text>
+inline std::size_t parseDecimalBatch(const KernelTable& table, const Text* tokens, std::size_t count, T* values,
+                                     ParseError* errors) {
+  std::size_t parsed = 0;
+  for (std::size_t base = 0; base < count; base += kBatchRows) {
+    detail::DecimalBlock block;
+    block.count = 0;
+    block.overlong = 0;
+    const std::size_t rows = count - base < kBatchRows ? count - base : kBatchRows;
+    for (std::size_t i = 0; i < rows; ++i) {
+      detail::addToBlock(block, tokens[base + i].data(), tokens[base + i].size());
+    }
+    detail::convertBlock(table, block, static_cast<u64>(std::numeric_limits<T>::max()));
+    for (std::size_t i = 0; i < rows; ++i) {
+      const bool ok = block.errors[i] == ParseError::None;
+      values[base + i] = ok ? static_cast<T>(block.values[i]) : T(0);
+      errors[base + i] = block.errors[i];
+      parsed += ok ? 1 : 0;
+    }
+  }
+  return parsed;
+}
+
+}  // namespace detail
+
+template <typename T, typename Text>
+inline std::size_t parseDecimalBatch(const Text* tokens, std::size_t count, T* values, ParseError* errors) {
+  static_assert(std::numeric_limits<T>::is_integer, "batch parsing needs an integer type.");
+  return detail::parseDecimalBatch(activeKernels(), tokens, count, values, errors);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Parsing and aggregating in one pass: the decimal tokens of text, separated by
+/// delimiter, go from the batch kernels straight into reducer.add(T value), with no
+/// array of values in between. A delimiter at the very end is allowed, so newline
+/// terminated columns work. Stops at the first token that fails, against the grammar
+/// or T's bound, and reports where it starts.
+struct ReduceResult {
+  ParseError error;    // None, or why the token at offset failed
+  std::size_t tokens;  // How many went into the reducer
+  std::size_t offset;  // Start of the failed token, or the text's length
+};
+
+template <typename T, typename Reducer>
+inline ReduceResult parseReduce(const char* text, std::size_t length, char delimiter, Reducer& reducer) {
+  static_assert(std::numeric_limits<T>::is_integer, "parse and reduce needs an integer type.");
+  const KernelTable& table = activeKernels();
+  ReduceResult result = {ParseError::None, 0, length};
+  const char* const end = text + length;
+  const char* p = text;
+  while (p < end) {
+    detail::DecimalBlock block;
+    block.count = 0;
+    block.overlong = 0;
+    while (block.count < kBatchRows && p < end) {
+      const char* stop = static_cast<const char*>(std::memchr(p, delimiter, static_cast<std::size_t>(end - p)));
+      stop = stop != nullptr ? stop : end;
+      detail::addToBlock(block, p, static_cast<std::size_t>(stop - p));
+      p = stop == end ? end : stop + 1;
+    }
+    detail::convertBlock(table, block, static_cast<u64>(std::numeric_limits<T>::max()));
+    for (std::size_t i = 0; i < block.count; ++i) {
+      if (block.errors[i] != ParseError::None) {
+        result.error = block.errors[i];
+        result.offset = static_cast<std::size_t>(block.texts[i] - text);
+        return result;
+      }
+      reducer.add(static_cast<T>(block.values[i]));
+      ++result.tokens;
+    }
+  }
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The built-in reducers. Tokens have no sign, so every value is at least zero.
+/// A sum that doesn't fit T sets overflow and stays at numeric_limits<T>::max().
+template <typename T>
+struct SumReducer {
+  T value = 0;
+  bool overflow = false;
+
+  void add(T x) {
+    if (x > std::numeric_limits<T>::max() - value) {
+      value = std::numeric_limits<T>::max();
+      overflow = true;
+    } else {
+      value += x;
+    }
+  }
+};
+
+/// Of no values at all, the minimum is numeric_limits<T>::max() and the maximum zero.
+template <typename T>
+struct MinReducer {
+  T value = std::numeric_limits<T>::max();
+
+  void add(T x) { value = x < value ? x : value; }
+};
+
+template <typename T>
+struct MaxReducer {
+  T value = 0;
+
+  void add(T x) { value = x > value ? x : value; }
+};
+
+struct CountReducer {
+  std::size_t count = 0;
+
+  template <typename T>
+  void add(T) {
+    ++count;
+  }
+};
+
+/// kBuckets buckets of width values each, the first starting at lowest. Values below
+/// the first bucket count in it, and values past the last in the last. The offset from
+/// lowest is taken in u64, where it can't overflow even when it doesn't fit T.
+template <typename T, std::size_t kBuckets>
+struct HistogramReducer {
+  static_assert(kBuckets > 0, "a histogram needs at least one bucket.");
+
+  HistogramReducer(T lowest_, T width_) : lowest(lowest_), width(width_ > 0 ? width_ : 1), counts() {}
+
+  void add(T x) {
+    const u64 bucket = x < lowest ? 0 : (static_cast<u64>(x) - static_cast<u64>(lowest)) / static_cast<u64>(width);
+    ++counts[bucket < kBuckets ? bucket : kBuckets - 1];
+  }
+
+  T lowest;
+  T width;
+  std::size_t counts[kBuckets];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Parsing with a filter: only the tokens a predicate keeps come out, as values, row
+/// indices, or both, so what gets written scales with the matches instead of the input.
+/// A predicate has match(values), which takes a block's kBatchRows parsed values and
+/// returns a bit per row that passes. The block is always full width, with rows that
+/// didn't parse zeroed, and the built-in predicates test all of it with the dispatched
+/// match-rows kernels. Tokens that fail to parse never match and are counted apart.
+struct SelectResult {
+  std::size_t selected;  // Rows written out
+  std::size_t failed;    // Rows that didn't parse or didn't fit T
+};
+
+/// lowest <= value <= highest.
+template <typename T>
+struct RangePredicate {
+  RangePredicate(T lowest_, T highest_) : lowest(0), span(0), empty(highest_ < lowest_ || highest_ < T()) {
+    lowest = lowest_ > T() ? static_cast<u64>(lowest_) : 0;
+    span = empty ? 0 : static_cast<u64>(highest_) - lowest;
+  }
+
+  unsigned match(const u64 (&values)[kBatchRows]) const {
+    return empty ? 0 : activeKernels().matchRange(values, lowest, span);
+  }
+
+  u64 lowest;
+  u64 span;
+  bool empty;
+};
+
+/// value is one of a handful, e.g. AnyOfPredicate<uint16_t, 3>{{500, 502, 503}}.
+template <typename T, std::size_t kSize>
+struct AnyOfPredicate {
+  unsigned match(const u64 (&values)[kBatchRows]) const {
+    const RowsMaskedKernel kernel = activeKernels().matchMasked;
+    unsigned matches = 0;
+    for (std::size_t i = 0; i < kSize; ++i) {
+      matches |= set[i] < T() ? 0 : kernel(values, ~u64{0}, static_cast<u64>(set[i]));
+    }
+    return matches;
+  }
+
+  T set[kSize];
+};
+
+/// (value & mask) == expected, e.g. {0x4, 0x4} for values with bit 2 set.
+template <typename T>
+struct BitmaskPredicate {
+  unsigned match(const u64 (&values)[kBatchRows]) const {
+    return activeKernels().matchMasked(values, static_cast<u64>(mask), static_cast<u64>(expected));
+  }
+
+  T mask;
+  T expected;
+};
+
+/// Either of values and rows may be null; each one given needs room for every match.
+template <typename T, typename Text, typename Predicate>
+inline SelectResult parseDecimalSelect(const Text* tokens, std::size_t count, const Predicate& predicate, T* values,
+                                       std::size_t* rows) {
+  static_assert(std::numeric_limits<T>::is_integer, "batch parsing needs an integer type.");
+  const KernelTable& table = activeKernels();
+  SelectResult result = {0, 0};
+  for (std::size_t base = 0; base < count; base += kBatchRows) {
+    detail::DecimalBlock block;
+    block.count = 0;
+    block.overlong = 0;
+    const std::size_t blockRows = count - base < kBatchRows ? count - base : kBatchRows;
+    for (std::size_t i = 0; i < blockRows; ++i) {
+      detail::addToBlock(block, tokens[base + i].data(), tokens[base + i].size());
+    }
+    detail::convertBlock(table, block, static_cast<u64>(std::numeric_limits<T>::max()));
+    unsigned parsed = 0;
+    for (std::size_t i = 0; i < kBatchRows; ++i) {
+      const bool ok = i < blockRows && block.errors[i] == ParseError::None;
+      parsed |= static_cast<unsigned>(ok) << i;
+      block.values[i] = ok ? block.values[i] : 0;
+      result.failed += i < blockRows && !ok ? 1 : 0;
+    }
+    for (unsigned matches = predicate.match(block.values) & parsed; matches != 0; matches &= matches - 1) {
+      const unsigned i = detail::countTrailingZeros(matches);
+      if (values != nullptr) {
+        values[result.selected] = static_cast<T>(block.values[i]);
+      }
+      if (rows != nullptr) {
+        rows[result.selected] = base + i;
+      }
+      ++result.selected;
+    }
+  }
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Dictionary encoding while parsing, for columns with few distinct values: each token
+/// comes out as a Code, a uint8_t or uint16_t index into the dictionary's values, which
+/// are kept in the order first seen. Codes are bounded the way checkValid_* bounds a
+/// literal, so a value that would need a code past numeric_limits<Code>::max() is an
+/// Overflow, the same as one past T's. A dictionary carries over between calls, so a
+/// column can be encoded in pieces.
+///
+/// Lookups go through an open addressed table of code + 1 per slot, zero for empty,
+/// with a multiplicative hash, which doubles whenever it gets half full. A probe ends
+/// at the value's slot or at the empty one it goes in, so a new value costs one probe,
+/// bar a second after the table doubles.
+template <typename T, typename Code>
+struct DecimalDictionary {
+  static_assert(std::numeric_limits<Code>::is_integer && !std::numeric_limits<Code>::is_signed && sizeof(Code) <= 2,
+                "dictionary codes are uint8_t or uint16_t.");
+  static constexpr std::size_t kMaxSize = std::size_t{std::numeric_limits<Code>::max()} + 1;
+
+  /// Finds value's code, adding value if it's new. Only fails once the codes run out.
+  ParseError encode(T value, Code& code) {
+    if (slots.empty()) {
+      grow();
+    }
+    std::size_t slot = probe(value);
+    if (slots[slot] != 0) {
+      code = static_cast<Code>(slots[slot] - 1);
+      return ParseError::None;
+    }
+    if (values.size() == kMaxSize) {
+      return ParseError::Overflow;
+    }
+    if (2 * (values.size() + 1) > slots.size()) {
+      grow();
+      slot = probe(value);
+    }
+    code = static_cast<Code>(values.size());
+    values.push_back(value);
+    slots[slot] = static_cast<std::uint32_t>(values.size());
+    return ParseError::None;
+  }
+
+  bool lookup(T value, Code& code) const {
+    if (slots.empty()) {
+      return false;
+    }
+    const std::size_t slot = probe(value);
+    if (slots[slot] == 0) {
+      return false;
+    }
+    code = static_cast<Code>(slots[slot] - 1);
+    return true;
+  }
+
+  std::vector<T> values;  // By code
+  std::vector<std::uint32_t> slots;
+
+ private:
+  std::size_t slotOf(T value) const {
+    return static_cast<std::size_t>((static_cast<u64>(value) * 0x9e3779b97f4a7c15u) >> 32) & (slots.size() - 1);
+  }
+
+  /// The slot holding value, or the empty slot that ends its run.
+  std::size_t probe(T value) const {
+    std::size_t slot = slotOf(value);
+    while (slots[slot] != 0 && values[slots[slot] - 1] != value) {
+      slot = (slot + 1) & (slots.size() - 1);
+    }
+    return slot;
+  }
+
+  void grow() {
+    slots.assign(slots.empty() ? 64 : 2 * slots.size(), 0);
+    for (std::size_t code = 0; code < values.size(); ++code) {
+      std::size_t slot = slotOf(values[code]);
+      while (slots[slot] != 0) {
+        slot = (slot + 1) & (slots.size() - 1);
+      }
+      slots[slot] = static_cast<std::uint32_t>(code + 1);
+    }
+  }
+};
+
+/// parseDecimalBatch, with codes[i] in place of each value: zero where errors[i] isn't
+/// None. Returns how many tokens were encoded.
+template <typename T, typename Code, typename Text>
+inline std::size_t parseDecimalDictionary(const Text* tokens, std::size_t count, DecimalDictionary<T, Code>& dictionary,
+                                          Code* codes, ParseError* errors) {
+  const KernelTable& table = activeKernels();
+  std::size_t encoded = 0;
+  for (std::size_t base = 0; base < count; base += kBatchRows) {
+    detail::DecimalBlock block;
+    block.count = 0;
+    block.overlong = 0;
+    const std::size_t rows = count - base < kBatchRows ? count - base : kBatchRows;
+    for (std::size_t i = 0; i < rows; ++i) {
+      detail::addToBlock(block, tokens[base + i].data(), tokens[base + i].size());
+    }
+    detail::convertBlock(table, block, static_cast<u64>(std::numeric_limits<T>::max()));
+    u64 hits = 0;
+    for (std::size_t i = 0; i < rows; ++i) {
+      Code code = 0;
+      ParseError error = block.errors[i];
+      if (error == ParseError::None) {
+        const std::size_t known = dictionary.values.size();
+        error = dictionary.encode(static_cast<T>(block.values[i]), code);
+        hits += error == ParseError::None && dictionary.values.size() == known ? 1 : 0;
+      }
+      codes[base + i] = error == ParseError::None ? code : Code(0);
+      errors[base + i] = error;
+      encoded += error == ParseError::None ? 1 : 0;
+    }
+    detail::recordCacheHits(hits);
+  }
+  return encoded;
+}
+
+/// Codes as narrow as the column's cardinality allows, the way checkValid_* picks the
+/// narrowest type a literal fits: a byte each while the dictionary has at most 256
+/// values, and once it grows past that, every code so far re-encoded as a uint16_t.
+struct DictionaryCodes {
+  std::vector<std::uint8_t> narrow;  // While width is 1
+  std::vector<std::uint16_t> wide;   // Once width is 2
+  unsigned width = 1;                // Bytes per code
+
+  std::size_t size() const { return width == 1 ? narrow.size() : wide.size(); }
+  std::size_t operator[](std::size_t i) const { return width == 1 ? narrow[i] : wide[i]; }
+
+  void widen() {
+    wide.assign(narrow.begin(), narrow.end());
+    narrow.clear();
+    width = 2;
+  }
+};
+
+/// parseDecimalDictionary appending to codes, which widen on the 257th distinct value
+/// instead of running out. Past 65536 values new ones are Overflow, as with uint16_t.
+template <typename T, typename Text>
+inline std::size_t parseDecimalDictionary(const Text* tokens, std::size_t count,
+                                          DecimalDictionary<T, std::uint16_t>& dictionary, DictionaryCodes& codes,
+                                          ParseError* errors) {
+  std::size_t encoded = 0;
+  for (std::size_t base = 0; base < count; base += kBatchRows) {
+    const std::size_t rows = count - base < kBatchRows ? count - base : kBatchRows;
+    std::uint16_t blockCodes[kBatchRows];
+    encoded += parseDecimalDictionary(tokens + base, rows, dictionary, blockCodes, errors + base);
+    if (codes.width == 1 && dictionary.values.size() > std::size_t{1} << 8) {
+      codes.widen();
+    }
+    if (codes.width == 1) {
+      codes.narrow.insert(codes.narrow.end(), blockCodes, blockCodes + rows);
+    } else {
+      codes.wide.insert(codes.wide.end(), blockCodes, blockCodes + rows);
+    }
+  }
+  return encoded;
+}
+
+#if SCW_INTLIT_HAS_PMR
+
+////////////////////////////////////////////////////////////////////////////////
+/// Columns in memory the caller picks. parseDecimalColumn returns its values and errors
+/// as std::pmr::vectors from a std::pmr::memory_resource instead of filling arrays, so a
+/// thread can parse into an arena rather than the global allocator, which every thread
+/// parsing at once contends on. Needs C++17; SCW_INTLIT_HAS_PMR says whether it's here.
+///
+/// ParseArena is the resource for parsing the same shape of batch over and over. It
+/// bumps a pointer through one block and frees nothing until reset(). What doesn't fit
+/// comes from upstream, and reset() then grows the block to all the round used, so from
+/// the second round of a shape on it never calls upstream at all.
+class ParseArena : public std::pmr::memory_resource {
+ public:
+  explicit ParseArena(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) : upstream_(upstream) {}
+  ParseArena(const ParseArena&) = delete;
+  ParseArena& operator=(const ParseArena&) = delete;
+  ~ParseArena() override {
+    releaseSpills();
+    if (block_ != nullptr) {
+      upstream_->deallocate(block_, capacity_, kBlockAlignment);
+    }
+  }
+
+  /// Takes back everything handed out since the last reset, which has to be dead by now.
+  void reset() {
+    const std::size_t used = used_ + spilled_;
+    releaseSpills();
+    if (used > capacity_) {
+      if (block_ != nullptr) {
+        upstream_->deallocate(block_, capacity_, kBlockAlignment);
+      }
+      capacity_ = (used + kBlockGranule - 1) & ~(kBlockGranule - 1);
+      block_ = static_cast<unsigned char*>(upstream_->allocate(capacity_, kBlockAlignment));
+    }
+    used_ = 0;
+  }
+
+  std::size_t capacity() const { return capacity_; }
+  std::size_t used() const { return used_ + spilled_; }  // Including what came from upstream
+
+ private:
+  static constexpr std::size_t kBlockAlignment = alignof(std::max_align_t);
+  static constexpr std::size_t kBlockGranule = 4096;
+
+  /// An allocation past the block, linked through a header in front of it.
+  struct Spill {
+    Spill* next;
+    std::size_t bytes;
+    std::size_t alignment;
+  };
+
+  static std::size_t spillHeader(std::size_t alignment) {
+    return (sizeof(Spill) + alignment - 1) & ~(alignment - 1);
+  }
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block_);
+    const std::uintptr_t at = (base + used_ + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    if (block_ != nullptr && at + bytes <= base + capacity_) {
+      used_ = static_cast<std::size_t>(at + bytes - base);
+      return block_ + (at - base);
+    }
+    alignment = alignment > alignof(Spill) ? alignment : alignof(Spill);
+    const std::size_t header = spillHeader(alignment);
+    unsigned char* memory = static_cast<unsigned char*>(upstream_->allocate(header + bytes, alignment));
+    Spill* spill = reinterpret_cast<Spill*>(memory + header - sizeof(Spill));
+    *spill = Spill{spills_, header + bytes, alignment};
+    spills_ = spill;
+    spilled_ += bytes + alignment;
+    return memory + header;
+  }
+
+  void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+  void releaseSpills() {
+    while (spills_ != nullptr) {
+      Spill* const spill = spills_;
+      spills_ = spill->next;
+      unsigned char* const end = reinterpret_cast<unsigned char*>(spill) + sizeof(Spill);
+      upstream_->deallocate(end - spillHeader(spill->alignment), spill->bytes, spill->alignment);
+    }
+    spilled_ = 0;
+  }
+
+  std::pmr::memory_resource* upstream_;
+  unsigned char* block_ = nullptr;
+  std::size_t capacity_ = 0;
+  std::size_t used_ = 0;
+  Spill* spills_ = nullptr;
+  std::size_t spilled_ = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// What a thread keeps between batch parses: the kernel table, looked up once instead
+/// of on every call, and a ParseArena the columns go into. Columns parsed through a
+/// context live until its next reset(). local() is the calling thread's own, made on
+/// first use; a context of its own can also pin a tier, from resolveKernels(), and say
+/// where its arena's blocks come from.
+class ParseContext {
+ public:
+  ParseContext() : table_(&activeKernels()) {}
+  explicit ParseContext(const KernelTable& table,
+                        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+      : table_(&table), arena_(upstream) {}
+  ParseContext(const ParseContext&) = delete;
+  ParseContext& operator=(const ParseContext&) = delete;
+
+  static ParseContext& local() {
+    static thread_local ParseContext context;
+    return context;
+  }
+
+  const KernelTable& kernels() const { return *table_; }
+  ParseArena& arena() { return arena_; }
+  void reset() { arena_.reset(); }
+
+ private:
+  const KernelTable* table_;
+  ParseArena arena_;
+};
+
+/// A parsed column: values[i] and errors[i] as from parseDecimalBatch.
+template <typename T>
+struct DecimalColumn {
+  explicit DecimalColumn(std::pmr::memory_resource* resource) : values(resource), errors(resource) {}
+
+  std::pmr::vector<T> values;
+  std::pmr::vector<ParseError> errors;
+  std::size_t parsed = 0;  // How many have no error
+};
+
+namespace detail {
+
+template <typename T, typename Text>
+inline DecimalColumn<T> parseDecimalColumn(const KernelTable& table, const Text* tokens, std::size_t count,
+                                           std::pmr::memory_resource* resource) {
+  static_assert(std::numeric_limits<T>::is_integer, "batch parsing needs an integer type.");
+  DecimalColumn<T> column(resource);
+  column.values.resize(count);
+  column.errors.resize(count);
+  column.parsed = parseDecimalBatch(table, tokens, count, column.values.data(), column.errors.data());
+  return column;
+}
+
+/// Delimited text goes through the same blocks as parseReduce, but every token lands.
+template <typename T>
+inline DecimalColumn<T> parseDecimalColumn(const KernelTable& table, const char* text, std::size_t length,
+                                           char delimiter, std::pmr::memory_resource* resource) {
+  static_assert(std::numeric_limits<T>::is_integer, "batch parsing needs an integer type.");
+  const char* const end = text + length;
+  std::size_t count = static_cast<std::size_t>(std::count(text, end, delimiter));
+  count += length != 0 && end[-1] != delimiter ? 1 : 0;
+  DecimalColumn<T> column(resource);
+  column.values.resize(count);
+  column.errors.resize(count);
+  const char* p = text;
+  for (std::size_t base = 0; base < count; base += kBatchRows) {
+    DecimalBlock block;
+    block.count = 0;
+    block.overlong = 0;
+    const std::size_t rows = count - base < kBatchRows ? count - base : kBatchRows;
+    for (std::size_t i = 0; i < rows; ++i) {
+      const char* stop = static_cast<const char*>(std::memchr(p, delimiter, static_cast<std::size_t>(end - p)));
+      stop = stop != nullptr ? stop : end;
+      addToBlock(block, p, static_cast<std::size_t>(stop - p));
+      p = stop == end ? end : stop + 1;
+    }
+    convertBlock(table, block, static_cast<u64>(std::numeric_limits<T>::max()));
+    for (std::size_t i = 0; i < rows; ++i) {
+      const bool ok = block.errors[i] == ParseError::None;
+      column.values[base + i] = ok ? static_cast<T>(block.values[i]) : T(0);
+      column.errors[base + i] = block.errors[i];
+      column.parsed += ok ? 1 : 0;
+    }
+  }
+  return column;
+}
+
+}  // namespace detail
+
+/// A column of tokens, each with data() and size(), as parseDecimalBatch takes them.
+template <typename T, typename Text>
+inline DecimalColumn<T> parseDecimalColumn(const Text* tokens, std::size_t count,
+                                           std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+  return detail::parseDecimalColumn<T>(activeKernels(), tokens, count, resource);
+}
+
+/// Delimited text, as parseReduce takes it: a delimiter at the very end is allowed, and
+/// an empty token between two is Empty.
+template <typename T>
+inline DecimalColumn<T> parseDecimalColumn(const char* text, std::size_t length, char delimiter,
+                                           std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+  return detail::parseDecimalColumn<T>(activeKernels(), text, length, delimiter, resource);
+}
+
+/// Through a context, each call counts a cache hit for the kernel table it didn't look up.
+template <typename T, typename Text>
+inline DecimalColumn<T> parseDecimalColumn(ParseContext& context, const Text* tokens, std::size_t count) {
+  detail::recordCacheHits(1);
+  return detail::parseDecimalColumn<T>(context.kernels(), tokens, count, &context.arena());
+}
+
+template <typename T>
+inline DecimalColumn<T> parseDecimalColumn(ParseContext& context, const char* text, std::size_t length,
+                                           char delimiter) {
+  detail::recordCacheHits(1);
+  return detail::parseDecimalColumn<T>(context.kernels(), text, length, delimiter, &context.arena());
+}
+
+#endif  // SCW_INTLIT_HAS_PMR
+
+#if defined(__SIZEOF_INT128__)
+
+////////////////////////////////////////////////////////////////////////////////
+/// 128-bit values, in the same grammar as the 64-bit entry points: formatting writes
+/// just the digits, bar a minus sign for a negative i128, and the parsers read that
+/// text back. Each piece goes through the dispatched 64-bit kernel, and like the 64-bit
+/// entry points the value is only written on success.
+namespace detail {
+
+inline std::size_t formatDecimal128(const KernelTable& table, u128 value, char* out) {
+  const u64 high = static_cast<u64>(value >> 64);
+  if (high == 0) {
+    return table.formatDecimal(static_cast<u64>(value), out);
+  }
+  // 10^19 is above 2^63, so the high limb holds it at most once, and so does the
+  // quotient unless the high limb did
+  const u64 wrapped = high >= kPower19 ? 1 : 0;
+  u64 lowDigits;
+  u64 middleDigits;
+  const u64 quotient = divPower19(high - wrapped * kPower19, static_cast<u64>(value), lowDigits);
+  u64 top;
+  if (wrapped == 0) {
+    top = quotient >= kPower19 ? 1 : 0;
+    middleDigits = quotient - top * kPower19;
+  } else {
+    top = divPower19(wrapped, quotient, middleDigits);
+  }
+  std::size_t length;
+  if (top == 0) {
+    length = table.formatDecimal(middleDigits, out);
+  } else {
+    length = table.formatDecimal(top, out);
+    formatDecimal19(middleDigits, out + length);
+    length += 19;
+  }
+  formatDecimal19(lowDigits, out + length);
+  return length + 19;
+}
+
+/// Up to 39 significant digits, folded in 19 at a time with an overflow check.
+inline ParseError parseDecimal128(const KernelTable& table, const char* digits, std::size_t length, u128& value) {
+  constexpr u128 kLimit = ~u128{0} / kPower19;
+  if (length == 0) {
+    return ParseError::Empty;
+  }
+  ParseError error = ParseError::None;
+  u128 acc = 0;
+  std::size_t width = length - (length - 1) / 19 * 19;
+  for (std::size_t at = 0; at < length; at += width, width = 19) {
+    u64 chunk;
+    if (table.parseDecimal(digits + at, width, chunk) != ParseError::None) {
+      return ParseError::InvalidDigit;  // Even past an overflow, like the 64-bit kernels
+    }
+    if (acc > kLimit || acc * kPower19 > ~u128{0} - chunk) {
+      error = ParseError::Overflow;
+    }
+    acc = acc * kPower19 + chunk;
+  }
+  if (error == ParseError::None) {
+    value = acc;
+  }
+  return error;
+}
+
+/// Hex and binary split at a limb boundary, the high part taking any leading zeros.
+inline ParseError parseSplit128(ParseKernel kernel, std::size_t lowDigits, const char* digits, std::size_t length,
+                                u128& value) {
+  if (length == 0) {
+    return ParseError::Empty;
+  }
+  const std::size_t highLength = length > lowDigits ? length - lowDigits : 0;
+  u64 high = 0;
+  u64 low = 0;
+  const ParseError highError = highLength != 0 ? kernel(digits, highLength, high) : ParseError::None;
+  const ParseError lowError = kernel(digits + highLength, length - highLength, low);
+  if (highError == ParseError::InvalidDigit || lowError != ParseError::None) {
+    return ParseError::InvalidDigit;
+  }
+  if (highError == ParseError::None) {
+    value = static_cast<u128>(high) << 64 | low;
+  }
+  return highError;
+}
+
+}  // namespace detail
+
+inline std::size_t formatDecimal128(u128 value, char* out) {
+  const KernelTable& table = activeKernels();
+  const std::size_t length = detail::formatDecimal128(table, value, out);
+  detail::recordFormat(table.isa[static_cast<std::size_t>(KernelOp::FormatDecimal)], length);
+  return length;
+}
+
+inline std::size_t formatDecimal128(i128 value, char* out) {
+  const KernelTable& table = activeKernels();
+  const bool negative = value < 0;
+  *out = '-';
+  const u128 magnitude = negative ? 0 - static_cast<u128>(value) : static_cast<u128>(value);
+  const std::size_t length = detail::formatDecimal128(table, magnitude, out + negative) + negative;
+  detail::recordFormat(table.isa[static_cast<std::size_t>(KernelOp::FormatDecimal)], length);
+  return length;
+}
+
+inline std::size_t formatHex128(u128 value, char* out) {
+  const KernelTable& table = activeKernels();
+  const u64 high = static_cast<u64>(value >> 64);
+  const u64 low = static_cast<u64>(value);
+  std::size_t length;
+  if (high == 0) {
+    length = table.formatHex(low, out);
+  } else {
+    length = table.formatHex(high, out);
+    detail::store64(out + length, detail::hexDigits8(low >> 32));
+    detail::store64(out + length + 8, detail::hexDigits8(low));
+    length += 16;
+  }
+  detail::recordFormat(table.isa[static_cast<std::size_t>(KernelOp::FormatHex)], length);
+  return length;
+}
+
+inline std::size_t formatBinary128(u128 value, char* out) {
+  const std::size_t length = detail::formatBinary128Swar(value, out);
+  detail::recordFormat(Isa::Swar, length);
+  return length;
+}
+
+inline ParseError parseDecimal128(const char* digits, std::size_t length, u128& value) {
+  const KernelTable& table = activeKernels();
+  const ParseError error = detail::parseDecimal128(table, digits, length, value);
+  detail::recordParse(table.isa[static_cast<std::size_t>(KernelOp::ParseDecimal)], length, error);
+  return error;
+}
+
+inline ParseError parseHex128(const char* digits, std::size_t length, u128& value) {
+  const KernelTable& table = activeKernels();
+  const ParseError error = detail::parseSplit128(table.parseHex, 16, digits, length, value);
+  detail::recordParse(table.isa[static_cast<std::size_t>(KernelOp::ParseHex)], length, error);
+  return error;
+}
+
+inline ParseError parseBinary128(const char* digits, std::size_t length, u128& value) {
+  const KernelTable& table = activeKernels();
+  const ParseError error = detail::parseSplit128(table.parseBinary, 64, digits, length, value);
+  detail::recordParse(table.isa[static_cast<std::size_t>(KernelOp::ParseBinary)], length, error);
+  return error;
+}
+
+#endif  // __SIZEOF_INT128__
+
+////////////////////////////////////////////////////////////////////////////////
+/// Address text, accepting exactly what inet_pton does. The IPv4 address comes back in
+/// network byte order, like in_addr and the _ipv4 literal.
+inline ParseError parseIpv4(const char* text, std::size_t length, std::uint32_t& address) {
+  const KernelTable& table = activeKernels();
+  const ParseError error = table.parseIpv4(text, length, address);
+  detail::recordParse(table.isa[static_cast<std::size_t>(KernelOp::ParseIpv4)], length, error);
+  return error;
+}
+
+inline ParseError parseIpv6(const char* text, std::size_t length, Ipv6Address& address) {
+  const KernelTable& table = activeKernels();
+  const ParseError error = table.parseIpv6(text, length, address);
+  detail::recordParse(table.isa[static_cast<std::size_t>(KernelOp::ParseIpv6)], length, error);
+  return error;
+}
+
+/// Writes what inet_ntop would, without a terminator: at most kMaxIpv4Chars or
+/// kMaxIpv6Chars characters.
+inline std::size_t formatIpv4(std::uint32_t address, char* out) {
+  const std::size_t length = detail::formatIpv4Scalar(address, out);
+  detail::recordFormat(Isa::Scalar, length);
+  return length;
+}
+
+inline std::size_t formatIpv6(const Ipv6Address& address, char* out) {
+  const std::size_t length = detail::formatIpv6Scalar(address, out);
+  detail::recordFormat(Isa::Scalar, length);
+  return length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Canonical UUID text, the same Uuid the _uuid literal gives. Either case parses;
+/// formatting writes exactly kUuidChars lower case characters, without a terminator.
+inline ParseError parseUuid(const char* text, std::size_t length, Uuid& uuid) {
+  const KernelTable& table = activeKernels();
+  const ParseError error = table.parseUuid(text, length, uuid);
+  detail::recordParse(table.isa[static_cast<std::size_t>(KernelOp::ParseUuid)], length, error);
+  return error;
+}
+
+inline std::size_t formatUuid(const Uuid& uuid, char* out) {
+  const KernelTable& table = activeKernels();
+  table.formatUuid(uuid, out);
+  detail::recordFormat(table.isa[static_cast<std::size_t>(KernelOp::FormatUuid)], kUuidChars);
+  return kUuidChars;
+}
+
+/// For keying hash maps on the parsed value.
+struct UuidHash {
+  std::size_t operator()(const Uuid& uuid) const {
+    namespace hash = intliterals::detail;
+    return static_cast<std::size_t>(hash::hashFinish(hash::hashStep(hash::kHashSeed, uuid.high, uuid.low)));
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Range lists, the way Linux writes cpulists: comma separated numbers and inclusive
+/// ranges such as 0-3,8,10-15, into a set of bitCount bits held as bit n % 64 of
+/// words[n / 64]. Numbers go through the dispatched decimal kernel, and a range is
+/// filled a word at a time. Empty text, or just the newline a sysfs file ends with, is
+/// the empty set. A number of bitCount or more is Overflow, an empty item or range end
+/// is Empty, and anything else wrong, a backwards range included, is InvalidDigit. On
+/// an error the set holds the items before the bad one.
+namespace detail {
+
+/// Sets first through last, which must be in order, as at most two partial words.
+inline void setBitRange(u64* words, u64 first, u64 last) {
+  const std::size_t low = static_cast<std::size_t>(first / 64);
+  const std::size_t high = static_cast<std::size_t>(last / 64);
+  const u64 lowMask = ~u64{0} << (first % 64);
+  const u64 highMask = ~u64{0} >> (63 - last % 64);
+  if (low == high) {
+    words[low] |= lowMask & highMask;
+    return;
+  }
+  words[low] |= lowMask;
+  for (std::size_t i = low + 1; i < high; ++i) {
+    words[i] = ~u64{0};
+  }
+  words[high] |= highMask;
+}
+
+inline ParseError parseListNumber(const KernelTable& table, const char* digits, const char* end, u64 bitCount,
+                                  u64& value) {
+  const std::size_t length = static_cast<std::size_t>(end - digits);
+  ParseError error = table.parseDecimal(digits, length, value);
+  recordParse(table.isa[static_cast<std::size_t>(KernelOp::ParseDecimal)], length, error);
+  return error == ParseError::None && value >= bitCount ? ParseError::Overflow : error;
+}
+
+}  // namespace detail
+
+inline ParseError parseRangeList(const char* text, std::size_t length, u64* words, std::size_t bitCount) {
+  std::memset(words, 0, (bitCount + 63) / 64 * sizeof(u64));
+  length -= length > 0 && text[length - 1] == '\n' ? 1 : 0;
+  if (length == 0) {
+    return ParseError::None;
+  }
+  const KernelTable& table = activeKernels();
+  const char* const end = text + length;
+  for (const char* item = text;;) {
+    const char* itemEnd = static_cast<const char*>(std::memchr(item, ',', static_cast<std::size_t>(end - item)));
+    itemEnd = itemEnd != nullptr ? itemEnd : end;
+    const char* dash = static_cast<const char*>(std::memchr(item, '-', static_cast<std::size_t>(itemEnd - item)));
+    u64 first = 0;
+    ParseError error = detail::parseListNumber(table, item, dash != nullptr ? dash : itemEnd, bitCount, first);
+    u64 last = first;
+    if (error == ParseError::None && dash != nullptr) {
+      error = detail::parseListNumber(table, dash + 1, itemEnd, bitCount, last);
+      error = error == ParseError::None && last < first ? ParseError::InvalidDigit : error;
+    }
+    if (error != ParseError::None) {
+      return error;
+    }
+    detail::setBitRange(words, first, last);
+    if (itemEnd == end) {
+      return ParseError::None;
+    }
+    item = itemEnd + 1;
+  }
+}
+
+/// The same into a bitset, a word at a time.
+template <std::size_t kBits>
+inline ParseError parseRangeList(const char* text, std::size_t length, std::bitset<kBits>& bits) {
+  u64 words[(kBits + 63) / 64];
+  const ParseError error = parseRangeList(text, length, words, kBits);
+  bits.reset();
+  for (std::size_t i = sizeof(words) / sizeof(words[0]); i-- > 0;) {
+    bits <<= 64;
+    bits |= std::bitset<kBits>(static_cast<unsigned long long>(words[i]));
+  }
+  return error;
+}
+
+/// A cpulist, as in /sys/devices/system/cpu/online, into the CpuSet the _cpuset literal gives.
+inline ParseError parseCpuList(const char* text, std::size_t length, CpuSet& cpus) {
+  return parseRangeList(text, length, cpus.words, 64 * kCpuSetWords);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Four or eight bytes as one integer in host byte order, for comparing against the
+/// _fourcc and _tag64 literals. No alignment needed.
+inline std::uint32_t loadTag32(const void* p) {
+  std::uint32_t tag;
+  std::memcpy(&tag, p, sizeof(tag));
+  return tag;
+}
+
+inline std::uint64_t loadTag64(const void* p) {
+  std::uint64_t tag;
+  std::memcpy(&tag, p, sizeof(tag));
+  return tag;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The runtime side of the _h64 literal: same value for the same bytes, with plain word
+/// loads instead of the literal's character by character ones. Keys of up to 16 bytes
+/// take two loads and one mixing step, with no loop.
+inline u64 hash64(const char* key, std::size_t length) {
+  namespace hash = intliterals::detail;
+  u64 state = hash::kHashSeed ^ length;
+  if (length > 16) {
+    const char* const end = key + length;
+    for (; end - key > 16; key += 16) {
+      state = hash::hashStep(state, detail::load64(key), detail::load64(key + 8));
+    }
+    state = hash::hashStep(state, detail::load64(end - 16), detail::load64(end - 8));
+  } else if (length >= 8) {
+    state = hash::hashStep(state, detail::load64(key), detail::load64(key + length - 8));
+  } else if (length >= 4) {
+    state = hash::hashStep(state, detail::load32(key), detail::load32(key + length - 4));
+  } else {
+    state = hash::hashStep(state, hash::hashTiny(key, length), 0);
+  }
+  return hash::hashFinish(state);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Identifier text: base-36 (0-9a-z) and Crockford base-32. Both parse either case;
+/// Crockford also takes I and L as 1 and O as 0. These run the table kernel on every
+/// tier and aren't part of the kernel table.
+inline ParseError parseBase36(const char* digits, std::size_t length, u64& value) {
+  const ParseError error = detail::parseIdentifier<36>(digits, length, value);
+  detail::recordParse(Isa::Scalar, length, error);
+  return error;
+}
+
+inline ParseError parseBase32(const char* digits, std::size_t length, u64& value) {
+  const ParseError error = detail::parseIdentifier<32>(digits, length, value);
+  detail::recordParse(Isa::Scalar, length, error);
+  return error;
+}
+
+/// Lower case, for a buffer of kMaxBase36Chars.
+inline std::size_t formatBase36(u64 value, char* out) {
+  const std::size_t length = detail::formatIdentifier<36>(value, out);
+  detail::recordFormat(Isa::Scalar, length);
+  return length;
+}
+
+/// Upper case, for a buffer of kMaxBase32Chars.
+inline std::size_t formatBase32(u64 value, char* out) {
+  const std::size_t length = detail::formatIdentifier<32>(value, out);
+  detail::recordFormat(Isa::Scalar, length);
+  return length;
+}
+
+}  // namespace intparse
+}  // namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE
@@ -0,0 +1,441 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reads the counters in /proc and /sys without allocating. A ProcFile keeps its
+/// descriptor open, and each poll preads the whole file from offset 0 into the
+/// caller's buffer, which is what makes the kernel regenerate it. The scanners then
+/// pull the fields out through the runtime decimal kernels of FixedWidthIntParse.h
+/// into plain structs of fixed width integers, without building a string or calling
+/// sscanf.
+///
+///  scanFields     - whitespace separated numbers, such as memory.current or cpu.max
+///  scanKeyed      - "key value" and "key: value" lines, such as /proc/meminfo or
+///                   memory.stat, into the struct members a table of keys names
+///  scanProcStat   - /proc/stat, the cpu lines and the scheduler counters
+///  scanPidStat    - /proc/<pid>/stat, whose command name can hold spaces and ')'
+///
+/// A field of "max", which cgroup files such as cpu.max and memory.max write for no
+/// limit, reads as numeric_limits<T>::max().
+///
+/// Every scanner returns a ScanResult: how many fields it set, and the first error.
+/// Fields a file doesn't have are left alone, so fill the struct before the scan.
+///
+/// Example
+/// -------
+///  #include "FixedWidthProcScan.h"
+///  using namespace scw::procscan;
+///  ProcFile file("/proc/meminfo");  // Once
+///  char buffer[8192];
+///  MemInfo memory = {};
+///  const long length = file.read(buffer, sizeof(buffer));  // Every poll
+///  if (length > 0 && scanKeyed(buffer, length, kMemInfoFields, memory).error == ParseError::None) { ... }
+///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "FixedWidthIntParse.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE {
+namespace procscan {
+
+using intparse::ParseError;
+using intparse::u64;
+
+struct ScanResult {
+  ParseError error;    // None, or why the first bad field failed
+  std::size_t fields;  // How many fields were set
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+
+////////////////////////////////////////////////////////////////////////////////
+/// A file kept open between polls. Reading preads from offset 0, so there's no seek
+/// and no shared offset, and several threads can read one ProcFile at once.
+struct ProcFile {
+  explicit ProcFile(const char* path) : fd(::open(path, O_RDONLY | O_CLOEXEC)) {}
+  ~ProcFile() {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+  ProcFile(const ProcFile&) = delete;
+  ProcFile& operator=(const ProcFile&) = delete;
+
+  bool isOpen() const { return fd >= 0; }
+
+  /// The whole file, or its first capacity bytes, into buffer. Returns the length, or
+  /// -1 with errno set. A length of capacity means the buffer may have been too small.
+  long read(char* buffer, std::size_t capacity) const {
+    std::size_t length = 0;
+    while (length < capacity) {
+      const ssize_t got = ::pread(fd, buffer + length, capacity - length, static_cast<off_t>(length));
+      if (got <= 0) {
+        return got == 0 ? static_cast<long>(length) : -1;
+      }
+      length += static_cast<std::size_t>(got);
+    }
+    return static_cast<long>(length);
+  }
+
+  int fd;
+};
+
+#endif
+
+namespace detail {
+
+inline bool isSpace(char ch) {
+  return ch == ' ' || ch == '\n' || ch == '\t';
+}
+
+/// Moves through whitespace separated fields, parsing each into the next member it's
+/// given. Once a field fails, the rest are skipped and error keeps the first failure.
+struct FieldCursor {
+  FieldCursor(const char* begin, const char* end_) : p(begin), end(end_), error(ParseError::None), fields(0) {}
+
+  /// The next field, without its surrounding whitespace; empty at the end.
+  std::size_t token(const char*& start) {
+    while (p < end && isSpace(*p)) {
+      ++p;
+    }
+    start = p;
+    while (p < end && !isSpace(*p)) {
+      ++p;
+    }
+    return static_cast<std::size_t>(p - start);
+  }
+
+  /// A decimal that fits T, with a leading '-' if T is signed, or "max" for T's largest.
+  /// A missing field is Empty unless optional, in which case value is left alone.
+  template <typename T>
+  void next(T& value, bool optional = false) {
+    const char* start;
+    std::size_t length = token(start);
+    if (error != ParseError::None || (length == 0 && optional)) {
+      return;
+    }
+    if (length == 3 && std::memcmp(start, "max", 3) == 0) {
+      value = std::numeric_limits<T>::max();
+      ++fields;
+      return;
+    }
+    const bool negative = std::numeric_limits<T>::is_signed && length > 1 && *start == '-';
+    start += negative ? 1 : 0;
+    length -= negative ? 1 : 0;
+    u64 magnitude = 0;
+    error = intparse::parseDecimal(start, length, magnitude);
+    const u64 bound = static_cast<u64>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+    error = error == ParseError::None && magnitude > bound ? ParseError::Overflow : error;
+    if (error == ParseError::None) {
+      value = negative ? static_cast<T>(-static_cast<T>(magnitude - 1) - 1) : static_cast<T>(magnitude);
+      ++fields;
+    }
+  }
+
+  const char* p;
+  const char* end;
+  ParseError error;
+  std::size_t fields;
+};
+
+}  // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////
+/// Up to count whitespace separated decimals into fields. Fewer is not an error; the
+/// result says how many there were.
+template <typename T>
+inline ScanResult scanFields(const char* text, std::size_t length, T* fields, std::size_t count) {
+  detail::FieldCursor cursor(text, text + length);
+  for (std::size_t i = 0; i < count && cursor.error == ParseError::None; ++i) {
+    cursor.next(fields[i], true);
+  }
+  return ScanResult{cursor.error, cursor.fields};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Keyed lines: the key runs to a ':' or whitespace, and the value is the next field
+/// on the line, so a " kB" after it is ignored. Only the keys in fields are parsed.
+/// Keys are looked for from just after the last one found, so listing them in the
+/// order the file has them makes each lookup a single compare.
+template <typename Struct>
+struct KeyedField {
+  const char* key;
+  u64 Struct::*member;
+};
+
+template <typename Struct, std::size_t kCount>
+inline ScanResult scanKeyed(const char* text, std::size_t length, const KeyedField<Struct> (&fields)[kCount],
+                            Struct& out) {
+  std::size_t keyLengths[kCount];
+  for (std::size_t i = 0; i < kCount; ++i) {
+    keyLengths[i] = std::strlen(fields[i].key);
+  }
+  ScanResult result = {ParseError::None, 0};
+  std::size_t next = 0;
+  const char* const end = text + length;
+  for (const char* line = text; line < end;) {
+    const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(end - line)));
+    lineEnd = lineEnd != nullptr ? lineEnd : end;
+    const char* keyEnd = line;
+    while (keyEnd < lineEnd && *keyEnd != ':' && !detail::isSpace(*keyEnd)) {
+      ++keyEnd;
+    }
+    const std::size_t keyLength = static_cast<std::size_t>(keyEnd - line);
+    for (std::size_t tried = 0; tried < kCount; ++tried) {
+      const std::size_t i = next + tried < kCount ? next + tried : next + tried - kCount;
+      if (keyLengths[i] == keyLength && std::memcmp(fields[i].key, line, keyLength) == 0) {
+        detail::FieldCursor cursor(keyEnd + (keyEnd < lineEnd && *keyEnd == ':' ? 1 : 0), lineEnd);
+        cursor.next(out.*fields[i].member);
+        if (cursor.error != ParseError::None) {
+          result.error = cursor.error;
+          return result;
+        }
+        ++result.fields;
+        next = i + 1 < kCount ? i + 1 : 0;
+        break;
+      }
+    }
+    line = lineEnd == end ? end : lineEnd + 1;
+  }
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// /proc/meminfo, in kB, and a cgroup v2 cpu.stat.
+struct MemInfo {
+  u64 total;
+  u64 free;
+  u64 available;
+  u64 buffers;
+  u64 cached;
+  u64 swapCached;
+  u64 active;
+  u64 inactive;
+  u64 swapTotal;
+  u64 swapFree;
+  u64 dirty;
+  u64 writeback;
+  u64 anonPages;
+  u64 mapped;
+  u64 shmem;
+  u64 slab;
+};
+
+const KeyedField<MemInfo> kMemInfoFields[] = {
+    {"MemTotal", &MemInfo::total},         {"MemFree", &MemInfo::free},        {"MemAvailable", &MemInfo::available},
+    {"Buffers", &MemInfo::buffers},        {"Cached", &MemInfo::cached},       {"SwapCached", &MemInfo::swapCached},
+    {"Active", &MemInfo::active},          {"Inactive", &MemInfo::inactive},   {"SwapTotal", &MemInfo::swapTotal},
+    {"SwapFree", &MemInfo::swapFree},      {"Dirty", &MemInfo::dirty},         {"Writeback", &MemInfo::writeback},
+    {"AnonPages", &MemInfo::anonPages},    {"Mapped", &MemInfo::mapped},       {"Shmem", &MemInfo::shmem},
+    {"Slab", &MemInfo::slab},
+};
+
+struct CgroupCpuStat {
+  u64 usageUsec;
+  u64 userUsec;
+  u64 systemUsec;
+  u64 periods;
+  u64 throttled;
+  u64 throttledUsec;
+};
+
+const KeyedField<CgroupCpuStat> kCgroupCpuStatFields[] = {
+    {"usage_usec", &CgroupCpuStat::usageUsec}, {"user_usec", &CgroupCpuStat::userUsec},
+    {"system_usec", &CgroupCpuStat::systemUsec}, {"nr_periods", &CgroupCpuStat::periods},
+    {"nr_throttled", &CgroupCpuStat::throttled}, {"throttled_usec", &CgroupCpuStat::throttledUsec},
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// /proc/stat. Times are in USER_HZ ticks; older kernels have fewer cpu columns, and
+/// the ones they lack are left alone. cpuN lines go to cpus[N] when N < cpuCapacity,
+/// and cpuCount is one past the highest N seen, whether or not it fit.
+struct CpuTimes {
+  u64 user;
+  u64 nice;
+  u64 system;
+  u64 idle;
+  u64 iowait;
+  u64 irq;
+  u64 softirq;
+  u64 steal;
+  u64 guest;
+  u64 guestNice;
+};
+
+struct ProcStat {
+  CpuTimes total;
+  std::size_t cpuCount;
+  u64 contextSwitches;
+  u64 bootTime;
+  u64 processes;
+  u64 running;
+  u64 blocked;
+};
+
+namespace detail {
+
+inline void scanCpuTimes(FieldCursor& cursor, CpuTimes& times) {
+  u64 CpuTimes::*const kColumns[] = {&CpuTimes::user,    &CpuTimes::nice,  &CpuTimes::system,  &CpuTimes::idle,
+                                     &CpuTimes::iowait,  &CpuTimes::irq,   &CpuTimes::softirq, &CpuTimes::steal,
+                                     &CpuTimes::guest,   &CpuTimes::guestNice};
+  for (u64 CpuTimes::*column : kColumns) {
+    cursor.next(times.*column, true);
+  }
+}
+
+}  // namespace detail
+
+inline ScanResult scanProcStat(const char* text, std::size_t length, ProcStat& stat, CpuTimes* cpus,
+                               std::size_t cpuCapacity) {
+  const KeyedField<ProcStat> kCounters[] = {
+      {"ctxt", &ProcStat::contextSwitches}, {"btime", &ProcStat::bootTime},
+      {"processes", &ProcStat::processes},  {"procs_running", &ProcStat::running},
+      {"procs_blocked", &ProcStat::blocked},
+  };
+  ScanResult result = {ParseError::None, 0};
+  const char* const end = text + length;
+  const char* line = text;
+  stat.cpuCount = 0;
+  // The cpu lines come first, then the counters; intr and softirq are long and skipped
+  while (line < end && end - line > 3 && std::memcmp(line, "cpu", 3) == 0) {
+    const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(end - line)));
+    lineEnd = lineEnd != nullptr ? lineEnd : end;
+    detail::FieldCursor cursor(line + 3, lineEnd);
+    CpuTimes* times = &stat.total;
+    if (line[3] != ' ') {
+      std::size_t cpu = 0;
+      cursor.next(cpu);
+      stat.cpuCount = cpu + 1 > stat.cpuCount ? cpu + 1 : stat.cpuCount;
+      times = cursor.error == ParseError::None && cpu < cpuCapacity ? cpus + cpu : nullptr;
+      cursor.fields = 0;
+    }
+    if (times != nullptr) {
+      detail::scanCpuTimes(cursor, *times);
+    }
+    result.fields += cursor.fields;
+    if (cursor.error != ParseError::None) {
+      result.error = cursor.error;
+      return result;
+    }
+    line = lineEnd == end ? end : lineEnd + 1;
+  }
+  if (line < end) {
+    const ScanResult counters = scanKeyed(line, static_cast<std::size_t>(end - line), kCounters, stat);
+    result.error = counters.error;
+    result.fields += counters.fields;
+  }
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// /proc/<pid>/stat, through field 24 (rss). The command name sits in parentheses and
+/// may hold anything, ')' included, so it ends at the last ')' in the file. Names are
+/// at most 15 characters, and command is always terminated.
+struct PidStat {
+  std::int32_t pid;
+  char command[16];
+  char state;
+  std::int32_t parent;
+  std::int32_t processGroup;
+  std::int32_t session;
+  std::int32_t tty;
+  std::int32_t terminalGroup;
+  std::uint32_t flags;
+  u64 minorFaults;
+  u64 childMinorFaults;
+  u64 majorFaults;
+  u64 childMajorFaults;
+  u64 userTime;    // Ticks
+  u64 systemTime;  // Ticks
+  std::int64_t childUserTime;
+  std::int64_t childSystemTime;
+  std::int64_t priority;
+  std::int64_t nice;
+  std::int64_t threads;
+  std::int64_t intervalTimer;
+  u64 startTime;     // Ticks after boot
+  u64 virtualBytes;
+  std::int64_t residentPages;
+};
+
+inline ScanResult scanPidStat(const char* text, std::size_t length, PidStat& stat) {
+  const char* open = static_cast<const char*>(std::memchr(text, '(', length));
+  const char* close = text + length;
+  while (close > text && close[-1] != ')') {
+    --close;
+  }
+  if (open == nullptr || close <= open) {
+    return ScanResult{length == 0 ? ParseError::Empty : ParseError::InvalidDigit, 0};
+  }
+  detail::FieldCursor cursor(text, open);
+  cursor.next(stat.pid);
+  if (cursor.error == ParseError::None) {
+    const std::size_t nameLength = static_cast<std::size_t>(close - 1 - (open + 1));
+    const std::size_t kept = nameLength < sizeof(stat.command) - 1 ? nameLength : sizeof(stat.command) - 1;
+    std::memcpy(stat.command, open + 1, kept);
+    stat.command[kept] = '\0';
+    ++cursor.fields;
+  }
+
+  cursor.p = close;
+  cursor.end = text + length;
+  const char* state;
+  if (cursor.error == ParseError::None && cursor.token(state) == 1) {
+    stat.state = *state;
+    ++cursor.fields;
+  } else if (cursor.error == ParseError::None) {
+    cursor.error = ParseError::InvalidDigit;
+  }
+  cursor.next(stat.parent);
+  cursor.next(stat.processGroup);
+  cursor.next(stat.session);
+  cursor.next(stat.tty);
+  cursor.next(stat.terminalGroup);
+  cursor.next(stat.flags);
+  cursor.next(stat.minorFaults);
+  cursor.next(stat.childMinorFaults);
+  cursor.next(stat.majorFaults);
+  cursor.next(stat.childMajorFaults);
+  cursor.next(stat.userTime);
+  cursor.next(stat.systemTime);
+  cursor.next(stat.childUserTime);
+  cursor.next(stat.childSystemTime);
+  cursor.next(stat.priority);
+  cursor.next(stat.nice);
+  cursor.next(stat.threads);
+  cursor.next(stat.intervalTimer);
+  cursor.next(stat.startTime);
+  cursor.next(stat.virtualBytes);
+  cursor.next(stat.residentPages);
+  return ScanResult{cursor.error, cursor.fields};
+}
+
+}  // namespace procscan
+}  // namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE
@@ -0,0 +1,352 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// This file contains the string-literal suffixes: literals whose text doesn't fit
+/// the integer literal grammar, like identifiers in base-36. They take the text as a
+/// class type template parameter, so it needs C++20. Values are computed and checked
+/// at compile time, and out of range values reuse the checkValid_* static_asserts of
+/// FixedWidthIntLiterals.h.
+///
+/// Implemented suffixes include b36u32, b36u64 (base-36, 0-9a-z) and b32u32, b32u64
+/// (Crockford base-32, which also reads I and L as 1 and O as 0). Case is ignored.
+/// fourcc and tag64 give the uint32_t/uint64_t that loading exactly 4 or 8 characters
+/// from memory produces on this host, so a tag match is one load and one compare.
+/// h64 hashes the text to the same value intparse::hash64 gives at runtime, for
+/// switching on string keys. ipv4 and cidr4 give addresses and networks in network
+/// byte order, the way in_addr holds them, so matching a network is an AND and a compare.
+/// uuid takes the canonical 8-4-4-4-12 hex text and gives a Uuid, two uint64_t.
+/// cpuset takes a Linux cpulist such as 0-3,8 and gives a CpuSet, 1024 bits.
+///
+/// Examples
+/// --------
+///  #include "FixedWidthStringLiterals.h"
+///  using namespace scw::intliterals;
+///  auto id = "zz9abc"_b36u64;  // id will be uint64_t
+///  auto shard = "3V"_b32u32;   // shard will be uint32_t
+///  if (loadTag32(p) == "RIFF"_fourcc) { ... }
+///  switch (hash64(key, length)) {
+///    case "content-length"_h64: ...  // still compare the key, hashes can collide
+///  }
+///  auto gateway = "10.1.0.1"_ipv4;     // uint32_t in network byte order
+///  if ("10.1.0.0/16"_cidr4.contains(addr.s_addr)) { ... }
+///  constexpr Uuid tenant = "123e4567-e89b-12d3-a456-426614174000"_uuid;
+///  constexpr CpuSet housekeeping = "0-3,8"_cpuset;
+///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "FixedWidthIntLiterals.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE {
+namespace intliterals {
+
+////////////////////////////////////////////////////////////////////////////////
+/// The literal's text as a structural type, without the terminator in size().
+template <std::size_t kSize>
+struct FixedString {
+  char text[kSize] = {};
+
+  constexpr FixedString(const char (&literal)[kSize]) {
+    for (std::size_t i = 0; i < kSize; ++i) {
+      text[i] = literal[i];
+    }
+  }
+  constexpr std::size_t size() const { return kSize - 1; }
+  constexpr char operator[](std::size_t i) const { return text[i]; }
+};
+
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+/// What parsing the text found. The operators turn each flag into its own static_assert.
+struct TextValue {
+  u64 value = 0;
+  bool valid = true;
+  bool fits = true;
+};
+
+template <unsigned kRadix, std::size_t kSize>
+constexpr TextValue parseIdentifierText(const FixedString<kSize>& text) {
+  using Powers = RadixPowers<u64, kRadix>;
+  TextValue result;
+  for (std::size_t i = 0; i < text.size(); ++i) {
+    const unsigned digit = kRadix == 36 ? base36ToValue(text[i]) : crockfordToValue(text[i]);
+    if (digit >= kRadix) {
+      result.valid = false;
+      return result;
+    }
+    result.fits = result.fits && Powers::fits(result.value, digit, 1);
+    result.value = result.value * kRadix + digit;
+  }
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The characters as they sit in memory, read back as one integer in host byte order.
+template <typename T, std::size_t kSize>
+constexpr T tagValue(const FixedString<kSize>& text) {
+  T value = 0;
+  for (std::size_t i = 0; i < text.size(); ++i) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    const std::size_t shift = 8 * (sizeof(T) - 1 - i);
+#else
+    const std::size_t shift = 8 * i;
+#endif
+    value |= static_cast<T>(static_cast<unsigned char>(text[i])) << shift;
+  }
+  return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Four bytes in memory order as a uint32_t, which for an address is network byte order.
+constexpr std::uint32_t networkOrder32(unsigned b0, unsigned b1, unsigned b2, unsigned b3) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  return (std::uint32_t{b0} << 24) | (std::uint32_t{b1} << 16) | (std::uint32_t{b2} << 8) | b3;
+#else
+  return (std::uint32_t{b3} << 24) | (std::uint32_t{b2} << 16) | (std::uint32_t{b1} << 8) | b0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Dotted-quad text with an optional /prefix. Strict, like inet_pton: four decimal
+/// octets, no leading zeros (inet_aton would read those as octal), nothing else. The
+/// octets are kept unchecked so each one can go through checkValid_uint8_t.
+struct Ipv4Text {
+  u64 octet[4] = {};
+  u64 prefix = 32;
+  bool valid = true;
+  bool hasPrefix = false;
+};
+
+template <std::size_t kSize>
+constexpr Ipv4Text parseIpv4Text(const FixedString<kSize>& text) {
+  Ipv4Text result;
+  std::size_t at = 0;
+  const auto number = [&](u64& value) {
+    const std::size_t start = at;
+    value = 0;
+    while (at < text.size() && text[at] >= '0' && text[at] <= '9' && at - start < 4) {
+      value = value * 10 + static_cast<u64>(text[at++] - '0');
+    }
+    return at != start && at - start < 4 && (text[start] != '0' || at - start == 1);
+  };
+  for (std::size_t i = 0; i < 4 && result.valid; ++i) {
+    result.valid = (i == 0 || text[at++] == '.') && number(result.octet[i]);
+  }
+  if (result.valid && at < text.size() && text[at] == '/') {
+    ++at;
+    result.hasPrefix = true;
+    result.valid = number(result.prefix) && result.prefix <= 32;
+  }
+  result.valid = result.valid && at == text.size();
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Canonical UUID text: 36 characters, hex digits in either case, hyphens at 8, 13,
+/// 18 and 23 and nowhere else.
+struct UuidText {
+  Uuid value = {0, 0};
+  bool valid = true;
+};
+
+template <std::size_t kSize>
+constexpr UuidText parseUuidText(const FixedString<kSize>& text) {
+  UuidText result;
+  std::size_t digits = 0;
+  for (std::size_t i = 0; i < text.size() && result.valid; ++i) {
+    if (i == 8 || i == 13 || i == 18 || i == 23) {
+      result.valid = text[i] == '-';
+      continue;
+    }
+    const unsigned digit = base36ToValue(text[i]);
+    result.valid = digit < 16;
+    u64& half = digits++ < 16 ? result.value.high : result.value.low;
+    half = half << 4 | digit;
+  }
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// A cpulist: comma separated decimal CPUs and inclusive first-last ranges, filled a
+/// word at a time like intparse::parseCpuList does. Empty text is the empty set.
+struct CpuSetText {
+  CpuSet value = {};
+  bool valid = true;
+  bool fits = true;     // Every CPU below 1024
+  bool ordered = true;  // No range runs backwards
+};
+
+template <std::size_t kSize>
+constexpr CpuSetText parseCpuSetText(const FixedString<kSize>& text) {
+  constexpr u64 kBits = 64 * kCpuSetWords;
+  CpuSetText result;
+  std::size_t at = 0;
+  const auto number = [&](u64& value) {
+    const std::size_t start = at;
+    value = 0;
+    for (; at < text.size() && text[at] >= '0' && text[at] <= '9'; ++at) {
+      value = value < kBits ? value * 10 + static_cast<u64>(text[at] - '0') : kBits;
+    }
+    result.fits = result.fits && value < kBits;
+    return at != start;
+  };
+  while (at < text.size() && result.valid && result.fits && result.ordered) {
+    u64 first = 0;
+    u64 last = 0;
+    result.valid = (at == 0 || text[at++] == ',') && number(first);
+    last = first;
+    if (result.valid && at < text.size() && text[at] == '-') {
+      ++at;
+      result.valid = number(last);
+    }
+    result.ordered = first <= last;
+    if (!result.valid || !result.fits || !result.ordered) {
+      break;
+    }
+    for (u64 word = first / 64; word <= last / 64; ++word) {
+      const u64 low = word == first / 64 ? ~u64{0} << (first % 64) : ~u64{0};
+      const u64 high = word == last / 64 ? ~u64{0} >> (63 - last % 64) : ~u64{0};
+      result.value.words[word] |= low & high;
+    }
+  }
+  return result;
+}
+
+}  // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////
+/// An IPv4 network with its mask, both in network byte order.
+struct Cidr4 {
+  std::uint32_t address;
+  std::uint32_t mask;
+
+  constexpr bool contains(std::uint32_t networkOrderAddress) const {
+    return (networkOrderAddress & mask) == address;
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// The identifier operators. The macros again, for the same reason as the checks.
+#define SCW_FIXEDWIDTH_DEFINE_IDENTIFIER_OPERATOR(typesuffix_, radix_, typename_, name_)         \
+  template <FixedString kText>                                                                  \
+  constexpr typename_ operator"" typesuffix_() {                                                \
+    constexpr detail::TextValue parsed = detail::parseIdentifierText<radix_>(kText);            \
+    static_assert(kText.size() > 0, name_ " literal is empty.");                                \
+    static_assert(parsed.valid, name_ " literal has a character outside its alphabet.");        \
+    static_assert(parsed.fits, name_ " literal doesn't fit in 64 bits.");                       \
+    return detail::checkValid_##typename_<parsed.value>();                                      \
+  }
+
+// clang-format off
+SCW_FIXEDWIDTH_DEFINE_IDENTIFIER_OPERATOR(_b36u32, 36, uint32_t, "base-36");
+SCW_FIXEDWIDTH_DEFINE_IDENTIFIER_OPERATOR(_b36u64, 36, uint64_t, "base-36");
+SCW_FIXEDWIDTH_DEFINE_IDENTIFIER_OPERATOR(_b32u32, 32, uint32_t, "base-32");
+SCW_FIXEDWIDTH_DEFINE_IDENTIFIER_OPERATOR(_b32u64, 32, uint64_t, "base-32");
+// clang-format on
+
+////////////////////////////////////////////////////////////////////////////////
+/// The tag operators. A tag has exactly as many characters as its type has bytes.
+#define SCW_FIXEDWIDTH_DEFINE_TAG_OPERATOR(typesuffix_, typename_, errorMessage_)  \
+  template <FixedString kText>                                                  \
+  constexpr typename_ operator"" typesuffix_() {                                \
+    static_assert(kText.size() == sizeof(typename_), errorMessage_);            \
+    return detail::tagValue<typename_>(kText);                                  \
+  }
+
+// clang-format off
+SCW_FIXEDWIDTH_DEFINE_TAG_OPERATOR(_fourcc, uint32_t, "fourcc literal must be exactly 4 characters.");
+SCW_FIXEDWIDTH_DEFINE_TAG_OPERATOR(_tag64, uint64_t, "tag64 literal must be exactly 8 characters.");
+// clang-format on
+
+////////////////////////////////////////////////////////////////////////////////
+/// The key hash. Two case labels that collide are already a duplicate case error, so
+/// a switch needs nothing more; distinctHashes() covers key sets used any other way.
+///
+///  static_assert(distinctHashes({"get"_h64, "put"_h64, "post"_h64}), "Key hashes collide");
+template <FixedString kText>
+constexpr uint64_t operator"" _h64() {
+  return detail::hashText(kText.text, kText.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The address operators. Every octet gets the uint8_t range check.
+template <FixedString kText>
+constexpr uint32_t operator"" _ipv4() {
+  constexpr detail::Ipv4Text parsed = detail::parseIpv4Text(kText);
+  static_assert(parsed.valid, "ipv4 literal must be four dotted decimal octets.");
+  static_assert(!parsed.hasPrefix, "ipv4 literal can't have a prefix length, use _cidr4.");
+  return detail::networkOrder32(detail::checkValid_uint8_t<parsed.octet[0]>(), detail::checkValid_uint8_t<parsed.octet[1]>(),
+                                detail::checkValid_uint8_t<parsed.octet[2]>(), detail::checkValid_uint8_t<parsed.octet[3]>());
+}
+
+template <FixedString kText>
+constexpr Cidr4 operator"" _cidr4() {
+  constexpr detail::Ipv4Text parsed = detail::parseIpv4Text(kText);
+  static_assert(parsed.valid, "cidr4 literal must be four dotted decimal octets and a /prefix of at most 32.");
+  static_assert(parsed.hasPrefix, "cidr4 literal needs a /prefix length.");
+  constexpr uint32_t kHostMask = parsed.prefix == 0 ? 0 : ~uint32_t{0} << (32 - parsed.prefix);
+  constexpr uint32_t kMask = detail::networkOrder32(kHostMask >> 24, (kHostMask >> 16) & 0xff, (kHostMask >> 8) & 0xff,
+                                                    kHostMask & 0xff);
+  constexpr uint32_t kAddress =
+      detail::networkOrder32(detail::checkValid_uint8_t<parsed.octet[0]>(), detail::checkValid_uint8_t<parsed.octet[1]>(),
+                             detail::checkValid_uint8_t<parsed.octet[2]>(), detail::checkValid_uint8_t<parsed.octet[3]>());
+  static_assert((kAddress & ~kMask) == 0, "cidr4 literal has address bits set past its prefix.");
+  return Cidr4{kAddress, kMask};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The UUID operator.
+template <FixedString kText>
+constexpr Uuid operator"" _uuid() {
+  constexpr detail::UuidText parsed = detail::parseUuidText(kText);
+  static_assert(kText.size() == 36, "uuid literal must be 36 characters, 8-4-4-4-12 hex digits.");
+  static_assert(parsed.valid, "uuid literal must be hex digits with hyphens at 8, 13, 18 and 23.");
+  return parsed.value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The CPU set operator.
+template <FixedString kText>
+constexpr CpuSet operator"" _cpuset() {
+  constexpr detail::CpuSetText parsed = detail::parseCpuSetText(kText);
+  static_assert(parsed.valid, "cpuset literal must be comma separated CPUs and first-last ranges, such as 0-3,8.");
+  static_assert(parsed.fits, "cpuset literal has a CPU past 1023.");
+  static_assert(parsed.ordered, "cpuset literal has a range that runs backwards.");
+  return parsed.value;
+}
+
+template <std::size_t kCount>
+constexpr bool distinctHashes(const uint64_t (&hashes)[kCount]) {
+  for (std::size_t i = 0; i < kCount; ++i) {
+    for (std::size_t j = i + 1; j < kCount; ++j) {
+      if (hashes[i] == hashes[j]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace intliterals
+}  // namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// This file contains tick literals: fixed width std::chrono durations for packed
+/// timestamps and deltas, where the standard's 64-bit durations waste cache.
+///
+/// Implemented suffixes are <unit><bits> for units ns, us, ms, s and widths 16, 32, 64,
+/// e.g. us32 is a std::chrono::duration<uint32_t, std::micro>. Counts are unsigned and
+/// range checked through the same checkValid_* static_asserts as the integer suffixes.
+///
+/// The types are plain std::chrono durations, so their operators are std::chrono's, and
+/// those work in the common type, which keeps the narrow rep: 1_ms16 > 20000_ns16 is
+/// false, as 1_ms16 becomes 16960ns in a uint16_t. compareTicks(a, b) is the exact
+/// comparison across units, returning -1, 0 or 1. It scales the coarser side by a
+/// constant multiply in 64 bits, and a count too big to scale compares greater without
+/// one. With a literal on that side the multiply happens at compile time, so comparing a
+/// packed us32 delta against 250_ms16 never divides the packed value. It's a named call
+/// rather than operator overloads so what a comparison means never depends on which
+/// using-directives are in scope. For arithmetic across units, duration_cast to a wide
+/// enough type first. duration_cast between tick types is constexpr as well.
+///
+/// Examples
+/// --------
+///  #include "FixedWidthTickLiterals.h"
+///  using namespace scw::intliterals;
+///  auto delta = 1500_us32;               // delta is TicksUs32, 4 bytes
+///  bool late = compareTicks(delta, 1_ms16) > 0;  // 1_ms16 becomes 1000us at compile time
+///  TicksNs64 ns = 3_us32;                // exact widening conversions are implicit
+///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "FixedWidthIntLiterals.h"
+
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+#include <type_traits>
+
+namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE {
+namespace intliterals {
+
+////////////////////////////////////////////////////////////////////////////////
+/// The tick types and their operators. The macros one more time.
+#define SCW_FIXEDWIDTH_DEFINE_TICK_OPERATOR(typesuffix_, alias_, typename_, period_) \
+  using alias_ = std::chrono::duration<typename_, period_>;                         \
+  template <char... digits>                                                         \
+  constexpr alias_ operator"" typesuffix_() {                                       \
+    return alias_(SCW_FIXEDWIDTH_LITERAL_VALUE(CheckValid_##typename_, digits));    \
+  }
+
+// clang-format off
+SCW_FIXEDWIDTH_DEFINE_TICK_OPERATOR(_ns16, TicksNs16, uint16_t, std::nano);
+SCW_FIXEDWIDTH_DEFINE_TICK_OPERATOR(_ns32, TicksNs32, uint32_t, std::nano);
+SCW_FIXEDWIDTH_DEFINE_TICK_OPERATOR(_ns64, TicksNs64, uint64_t, std::nano);
+SCW_FIXEDWIDTH_DEFINE_TICK_OPERATOR(_us16, TicksUs16, uint16_t, std::micro);
+SCW_FIXEDWIDTH_DEFINE_TICK_OPERATOR(_us32, TicksUs32, uint32_t, std::micro);
+SCW_FIXEDWIDTH_DEFINE_TICK_OPERATOR(_us64, TicksUs64, uint64_t, std::micro);
+SCW_FIXEDWIDTH_DEFINE_TICK_OPERATOR(_ms16, TicksMs16, uint16_t, std::milli);
+SCW_FIXEDWIDTH_DEFINE_TICK_OPERATOR(_ms32, TicksMs32, uint32_t, std::milli);
+SCW_FIXEDWIDTH_DEFINE_TICK_OPERATOR(_ms64, TicksMs64, uint64_t, std::milli);
+SCW_FIXEDWIDTH_DEFINE_TICK_OPERATOR(_s16, TicksS16, uint16_t, std::ratio<1>);
+SCW_FIXEDWIDTH_DEFINE_TICK_OPERATOR(_s32, TicksS32, uint32_t, std::ratio<1>);
+SCW_FIXEDWIDTH_DEFINE_TICK_OPERATOR(_s64, TicksS64, uint64_t, std::ratio<1>);
+// clang-format on
+
+////////////////////////////////////////////////////////////////////////////////
+/// Comparisons across units. The periods are powers of ten, so one always divides the
+/// other and the coarser count only ever needs scaling up.
+namespace detail {
+
+/// -1, 0 or 1 as coarse * factor is less than, equal to or greater than fine.
+constexpr int compareScaled(uint64_t coarse, uint64_t factor, uint64_t fine) {
+  return coarse > UINT64_MAX / factor ? 1 : coarse * factor < fine ? -1 : coarse * factor > fine ? 1 : 0;
+}
+
+}  // namespace detail
+
+/// -1, 0 or 1 as a is shorter than, as long as or longer than b, exactly, whatever the units.
+template <typename RepA, typename PeriodA, typename RepB, typename PeriodB>
+constexpr int compareTicks(std::chrono::duration<RepA, PeriodA> a, std::chrono::duration<RepB, PeriodB> b) {
+  using Ratio = std::ratio_divide<PeriodA, PeriodB>;
+  static_assert(std::is_unsigned<RepA>::value && std::is_unsigned<RepB>::value, "tick counts are unsigned.");
+  static_assert(Ratio::num == 1 || Ratio::den == 1, "tick periods must divide one another.");
+  return Ratio::den == 1 ? detail::compareScaled(a.count(), Ratio::num, b.count())
+                         : -detail::compareScaled(b.count(), Ratio::den, a.count());
+}
+
+}  // namespace intliterals
+}  // namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE
@@ -0,0 +1,647 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// This file contains wide integers as limb arrays: literals for 128 to 512 bit
+/// constants, and the add, subtract, multiply and Montgomery multiply that moduli and
+/// field elements need. It needs C++17 for constexpr std::array access.
+///
+/// A Limbs<N> is N uint64_t, least significant limb first. Every operation is constexpr
+/// and written once over portable 64x64->128 bit multiplies, so a static_assert can check
+/// a literal-derived constant with the same code the program runs. At runtime
+/// montgomeryMul() switches to MULX/ADX kernels where the CPU has BMI2 and ADX, unless
+/// SCW_INTLIT_ISA caps dispatch below avx2. Every loop over limbs is unrolled through
+/// templates, so each N compiles to straight-line code with constant limb indexes.
+///
+/// Implemented suffixes are w128, w192, w256, w320, w384, w448 and w512, for N = 2..8.
+/// They take decimal, 0x hex, 0b binary and 0 octal digits like the integer suffixes,
+/// and a value that doesn't fit the width is a compile error.
+///
+/// parseDecimal() reads decimal text of any length at runtime, into a Limbs<N> or, for
+/// numbers past 512 bits, a LimbVector. Long inputs convert in O(n^1.58) rather than
+/// O(n^2), by divide and conquer over precomputed powers of ten.
+///
+/// Examples
+/// --------
+///  #include "FixedWidthWideInt.h"
+///  using namespace scw::intliterals;
+///  using namespace scw::wideint;
+///  constexpr auto p = 0xffffffff00000001000000000000000000000000ffffffffffffffffffffffff_w256;
+///  constexpr u64 inverse = montgomeryInverse(p[0]);
+///  auto x = montgomeryMul(a, montgomeryR2(p), p, inverse);  // a into Montgomery form
+///  auto product = montgomeryMul(x, y, p, inverse);          // x * y / 2^256 mod p
+///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "FixedWidthIntParse.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// The MULX/ADX rows are inline asm, so they need x86-64 and GNU asm syntax. The CPU
+// check happens at runtime; the assembler only has to know the instructions.
+#if SCW_INTLIT_X86_KERNELS && defined(__x86_64__)
+#define SCW_WIDEINT_ADX_KERNELS 1
+#else
+#define SCW_WIDEINT_ADX_KERNELS 0
+#endif
+
+namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE {
+namespace wideint {
+
+using u64 = std::uint64_t;
+
+template <std::size_t kLimbs>
+using Limbs = std::array<u64, kLimbs>;
+
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+/// One limb step of each operation, with the carry or the high half passed along.
+constexpr u64 addCarry(u64 a, u64 b, u64& carry) {
+  const u64 sum = a + b;
+  const u64 total = sum + carry;
+  carry = (sum < a ? 1u : 0u) + (total < sum ? 1u : 0u);
+  return total;
+}
+
+constexpr u64 subBorrow(u64 a, u64 b, u64& borrow) {
+  const u64 difference = a - b;
+  const u64 total = difference - borrow;
+  borrow = (a < b ? 1u : 0u) + (difference < borrow ? 1u : 0u);
+  return total;
+}
+
+/// a * b + c + d, which always fits in 128 bits. Low half returned, high half in d.
+constexpr u64 mulAdd(u64 a, u64 b, u64 c, u64& d) {
+#if defined(__SIZEOF_INT128__)
+  const intparse::u128 product = static_cast<intparse::u128>(a) * b + c + d;
+  d = static_cast<u64>(product >> 64);
+  return static_cast<u64>(product);
+#else
+  const u64 aLow = a & 0xffffffffu;
+  const u64 aHigh = a >> 32;
+  const u64 bLow = b & 0xffffffffu;
+  const u64 bHigh = b >> 32;
+  const u64 lowLow = aLow * bLow;
+  const u64 middle = aHigh * bLow + (lowLow >> 32);
+  const u64 cross = aLow * bHigh + (middle & 0xffffffffu);
+  u64 high = aHigh * bHigh + (middle >> 32) + (cross >> 32);
+  u64 low = (cross << 32) | (lowLow & 0xffffffffu);
+  u64 carry = 0;
+  low = addCarry(low, c, carry);
+  high += carry;
+  carry = 0;
+  low = addCarry(low, d, carry);
+  d = high + carry;
+  return low;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calls body(i) for i in [0, kCount) as a compile time constant, so every limb loop is
+/// written out in full for its N with constant limb indexes.
+template <typename Body, unsigned... kIndex>
+constexpr void unrollList(Body& body, intliterals::detail::IndexList<kIndex...>) {
+  (body(std::integral_constant<std::size_t, kIndex>()), ...);
+}
+
+template <std::size_t kCount, typename Body>
+constexpr void unroll(Body&& body) {
+  unrollList(body, typename intliterals::detail::MakeIndexList<kCount>::type());
+}
+
+template <std::size_t kLimbs>
+constexpr Limbs<2 * kLimbs> mulPortable(const Limbs<kLimbs>& a, const Limbs<kLimbs>& b) {
+  Limbs<2 * kLimbs> product = {};
+  unroll<kLimbs>([&](auto i) {
+    u64 carry = 0;
+    unroll<kLimbs>([&](auto j) { product[i + j] = mulAdd(a[j], b[i], product[i + j], carry); });
+    product[i + kLimbs] = carry;
+  });
+  return product;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Montgomery multiplication, coarsely integrated operand scanning: each round adds
+/// a * b[i], then the multiple of the modulus that clears the low limb, and shifts
+/// down a limb. The result is below 2 * modulus, so one conditional subtract finishes.
+template <std::size_t kLimbs>
+constexpr Limbs<kLimbs> montgomeryPortable(const Limbs<kLimbs>& a, const Limbs<kLimbs>& b,
+                                           const Limbs<kLimbs>& modulus, u64 inverse) {
+  Limbs<kLimbs + 2> t = {};
+  unroll<kLimbs>([&](auto i) {
+    u64 carry = 0;
+    unroll<kLimbs>([&](auto j) { t[j] = mulAdd(a[j], b[i], t[j], carry); });
+    u64 overflow = 0;
+    t[kLimbs] = addCarry(t[kLimbs], carry, overflow);
+    t[kLimbs + 1] = overflow;
+
+    const u64 m = t[0] * inverse;
+    carry = 0;
+    mulAdd(m, modulus[0], t[0], carry);
+    unroll<kLimbs - 1>([&](auto j) { t[j] = mulAdd(m, modulus[j + 1], t[j + 1], carry); });
+    overflow = 0;
+    t[kLimbs - 1] = addCarry(t[kLimbs], carry, overflow);
+    t[kLimbs] = t[kLimbs + 1] + overflow;
+  });
+
+  Limbs<kLimbs> result = {};
+  Limbs<kLimbs> reduced = {};
+  u64 borrow = 0;
+  unroll<kLimbs>([&](auto i) {
+    result[i] = t[i];
+    reduced[i] = subBorrow(t[i], modulus[i], borrow);
+  });
+  return t[kLimbs] != 0 || borrow == 0 ? reduced : result;
+}
+
+#if SCW_WIDEINT_ADX_KERNELS
+
+////////////////////////////////////////////////////////////////////////////////
+/// Montgomery multiplication with MULX, which leaves the flags alone, and ADCX/ADOX, which
+/// carry through CF and OF only, so a row's low and high product halves accumulate as
+/// two independent carry chains. Compilers turn the _addcarryx_u64 intrinsic into
+/// plain ADC with the carries spilled through SETC, so each row is one asm block,
+/// spelled out per limb count: t[0..N] += a[0..N-1] * multiplier.
+#define SCW_WIDEINT_ADX_STEP(j_)                 \
+  "mulxq 8*" #j_ "(%[a]), %%r8, %%r9\n\t"        \
+  "adcxq 8*" #j_ "(%[t]), %%r8\n\t"              \
+  "movq %%r8, 8*" #j_ "(%[t])\n\t"               \
+  "adoxq 8+8*" #j_ "(%[t]), %%r9\n\t"            \
+  "movq %%r9, 8+8*" #j_ "(%[t])\n\t"
+
+#define SCW_WIDEINT_ADX_ROW2 SCW_WIDEINT_ADX_STEP(0) SCW_WIDEINT_ADX_STEP(1)
+#define SCW_WIDEINT_ADX_ROW3 SCW_WIDEINT_ADX_ROW2 SCW_WIDEINT_ADX_STEP(2)
+#define SCW_WIDEINT_ADX_ROW4 SCW_WIDEINT_ADX_ROW3 SCW_WIDEINT_ADX_STEP(3)
+#define SCW_WIDEINT_ADX_ROW5 SCW_WIDEINT_ADX_ROW4 SCW_WIDEINT_ADX_STEP(4)
+#define SCW_WIDEINT_ADX_ROW6 SCW_WIDEINT_ADX_ROW5 SCW_WIDEINT_ADX_STEP(5)
+#define SCW_WIDEINT_ADX_ROW7 SCW_WIDEINT_ADX_ROW6 SCW_WIDEINT_ADX_STEP(6)
+#define SCW_WIDEINT_ADX_ROW8 SCW_WIDEINT_ADX_ROW7 SCW_WIDEINT_ADX_STEP(7)
+
+// Clearing eax clears CF and OF. Afterwards both chains' carries go into t[N + 1].
+#define SCW_WIDEINT_ADX_ROW_ASM(row_)                                             \
+  __asm__("xorl %%eax, %%eax\n\t" row_                                           \
+          "movl $0, %%ecx\n\t"                                                   \
+          "adcxq %%rax, %%rcx\n\t"                                               \
+          "adoxq %%rax, %%rax\n\t"                                               \
+          "addq %%rcx, %c[top](%[t])\n\t"                                        \
+          "adcq %%rax, 8+%c[top](%[t])"                                          \
+          :                                                                      \
+          : [t] "r"(t), [a] "r"(a), "d"(multiplier), [top] "i"(8 * kLimbs)       \
+          : "rax", "rcx", "r8", "r9", "cc", "memory")
+
+template <std::size_t kLimbs>
+inline void mulRowAdx(u64* t, const u64* a, u64 multiplier) {
+  if constexpr (kLimbs == 2) {
+    SCW_WIDEINT_ADX_ROW_ASM(SCW_WIDEINT_ADX_ROW2);
+  } else if constexpr (kLimbs == 3) {
+    SCW_WIDEINT_ADX_ROW_ASM(SCW_WIDEINT_ADX_ROW3);
+  } else if constexpr (kLimbs == 4) {
+    SCW_WIDEINT_ADX_ROW_ASM(SCW_WIDEINT_ADX_ROW4);
+  } else if constexpr (kLimbs == 5) {
+    SCW_WIDEINT_ADX_ROW_ASM(SCW_WIDEINT_ADX_ROW5);
+  } else if constexpr (kLimbs == 6) {
+    SCW_WIDEINT_ADX_ROW_ASM(SCW_WIDEINT_ADX_ROW6);
+  } else if constexpr (kLimbs == 7) {
+    SCW_WIDEINT_ADX_ROW_ASM(SCW_WIDEINT_ADX_ROW7);
+  } else {
+    SCW_WIDEINT_ADX_ROW_ASM(SCW_WIDEINT_ADX_ROW8);
+  }
+}
+
+#undef SCW_WIDEINT_ADX_ROW_ASM
+
+/// CIOS again, but rather than shifting down a limb each round the window slides up
+/// one, so round i works on t[i..i + N + 1] and the result ends up in t[N..2N].
+template <std::size_t kLimbs>
+inline Limbs<kLimbs> montgomeryAdx(const Limbs<kLimbs>& a, const Limbs<kLimbs>& b, const Limbs<kLimbs>& modulus,
+                                   u64 inverse) {
+  u64 t[2 * kLimbs + 2] = {};
+  unroll<kLimbs>([&](auto i) {
+    mulRowAdx<kLimbs>(t + i, a.data(), b[i]);
+    mulRowAdx<kLimbs>(t + i, modulus.data(), t[i] * inverse);
+  });
+
+  Limbs<kLimbs> result;
+  Limbs<kLimbs> reduced;
+  u64 borrow = 0;
+  unroll<kLimbs>([&](auto i) {
+    result[i] = t[kLimbs + i];
+    reduced[i] = subBorrow(t[kLimbs + i], modulus[i], borrow);
+  });
+  return t[2 * kLimbs] != 0 || borrow == 0 ? reduced : result;
+}
+
+#endif  // SCW_WIDEINT_ADX_KERNELS
+
+/// Whether the runtime side takes the MULX/ADX kernels. Resolved once, like the
+/// intparse kernel table, and subject to the same SCW_INTLIT_ISA cap.
+inline bool useAdx() {
+#if SCW_WIDEINT_ADX_KERNELS
+  static const bool kUse = intparse::activeKernels().limit >= intparse::Isa::Avx2 &&
+                           __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx");
+  return kUse;
+#else
+  return false;
+#endif
+}
+
+constexpr bool constantEvaluated() {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_is_constant_evaluated();
+#else
+  return true;
+#endif
+}
+
+}  // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////
+/// sum = a + b, returning the carry out of the top limb.
+template <std::size_t kLimbs>
+constexpr u64 add(const Limbs<kLimbs>& a, const Limbs<kLimbs>& b, Limbs<kLimbs>& sum) {
+  u64 carry = 0;
+  detail::unroll<kLimbs>([&](auto i) { sum[i] = detail::addCarry(a[i], b[i], carry); });
+  return carry;
+}
+
+/// difference = a - b, returning the borrow out of the top limb.
+template <std::size_t kLimbs>
+constexpr u64 sub(const Limbs<kLimbs>& a, const Limbs<kLimbs>& b, Limbs<kLimbs>& difference) {
+  u64 borrow = 0;
+  detail::unroll<kLimbs>([&](auto i) { difference[i] = detail::subBorrow(a[i], b[i], borrow); });
+  return borrow;
+}
+
+/// -1, 0 or 1 as a is below, equal to or above b.
+template <std::size_t kLimbs>
+constexpr int compare(const Limbs<kLimbs>& a, const Limbs<kLimbs>& b) {
+  int order = 0;
+  detail::unroll<kLimbs>([&](auto i) {
+    if (a[i] != b[i]) {
+      order = a[i] < b[i] ? -1 : 1;  // The highest differing limb comes last
+    }
+  });
+  return order;
+}
+
+/// The full double width product. Compiled from the portable code, the whole product
+/// stays in registers, which beats the MULX/ADX rows and their scratch in memory.
+template <std::size_t kLimbs>
+constexpr Limbs<2 * kLimbs> mul(const Limbs<kLimbs>& a, const Limbs<kLimbs>& b) {
+  static_assert(kLimbs >= 2 && kLimbs <= 8, "wide integers have 2 to 8 limbs.");
+  return detail::mulPortable(a, b);
+}
+
+/// -modulus^-1 mod 2^64 for an odd low limb, the constant montgomeryMul() needs. Each
+/// Newton step doubles the correct low bits, and an odd x is its own inverse mod 8.
+constexpr u64 montgomeryInverse(u64 lowLimb) {
+  u64 inverse = lowLimb;
+  for (int i = 0; i < 5; ++i) {
+    inverse *= 2 - lowLimb * inverse;
+  }
+  return 0 - inverse;
+}
+
+/// a * b * 2^(-64 * kLimbs) mod modulus, for an odd modulus and a, b below it. From
+/// four limbs up the two carry chains of the MULX/ADX rows win; below that the
+/// portable code's shorter dependency chain does.
+template <std::size_t kLimbs>
+constexpr Limbs<kLimbs> montgomeryMul(const Limbs<kLimbs>& a, const Limbs<kLimbs>& b, const Limbs<kLimbs>& modulus,
+                                      u64 inverse) {
+  static_assert(kLimbs >= 2 && kLimbs <= 8, "wide integers have 2 to 8 limbs.");
+#if SCW_WIDEINT_ADX_KERNELS
+  if (kLimbs >= 4 && !detail::constantEvaluated() && detail::useAdx()) {
+    return detail::montgomeryAdx(a, b, modulus, inverse);
+  }
+#endif
+  return detail::montgomeryPortable(a, b, modulus, inverse);
+}
+
+/// 2^(128 * kLimbs) mod modulus, which montgomeryMul() by turns a value into Montgomery
+/// form. Meant for constants: it takes 128 * kLimbs modular doublings.
+template <std::size_t kLimbs>
+constexpr Limbs<kLimbs> montgomeryR2(const Limbs<kLimbs>& modulus) {
+  Limbs<kLimbs> r = {};
+  Limbs<kLimbs> zero = {};
+  r[0] = 1;
+  if (compare(r, modulus) >= 0) {
+    return zero;
+  }
+  for (std::size_t i = 0; i < 128 * kLimbs; ++i) {
+    Limbs<kLimbs> doubled = {};
+    Limbs<kLimbs> reduced = {};
+    const u64 carry = add(r, r, doubled);
+    const u64 borrow = sub(doubled, modulus, reduced);
+    r = carry != 0 || borrow == 0 ? reduced : doubled;
+  }
+  return r;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Decimal strings longer than a Limbs<N> holds. Digits go 19 at a time, 10^19 being
+/// the largest power of ten below 2^64, through the dispatched decimal kernel. Folding
+/// the chunks in one at a time costs a multiply across the whole accumulator per chunk,
+/// so quadratic in the length. Instead the chunks split in two, the low half a power of
+/// two chunks long, and value = high * 10^(19 * 2^k) + low, each half converted the same
+/// way. The powers are squares of one another, and products that big go to Karatsuba.
+using LimbVector = std::vector<u64>;
+
+namespace detail {
+
+/// 10^19, and how many chunks a short run folds in one at a time.
+constexpr u64 kChunkPower = 10000000000000000000ull;
+constexpr std::size_t kChunkDigits = 19;
+constexpr std::size_t kHornerChunks = 64;
+
+/// Below this many limbs in the shorter operand, schoolbook multiplication wins.
+constexpr std::size_t kKaratsubaLimbs = 32;
+
+/// out[0..outLength) += b[0..bLength), carrying up as far as needed.
+inline void addInto(u64* out, std::size_t outLength, const u64* b, std::size_t bLength) {
+  u64 carry = 0;
+  std::size_t i = 0;
+  for (; i < bLength; ++i) {
+    out[i] = addCarry(out[i], b[i], carry);
+  }
+  for (; carry != 0 && i < outLength; ++i) {
+    out[i] = addCarry(out[i], 0, carry);
+  }
+}
+
+/// out[0..outLength) -= b[0..bLength), which must not go negative.
+inline void subtractFrom(u64* out, std::size_t outLength, const u64* b, std::size_t bLength) {
+  u64 borrow = 0;
+  std::size_t i = 0;
+  for (; i < bLength; ++i) {
+    out[i] = subBorrow(out[i], b[i], borrow);
+  }
+  for (; borrow != 0 && i < outLength; ++i) {
+    out[i] = subBorrow(out[i], 0, borrow);
+  }
+}
+
+inline std::size_t significantLimbs(const u64* limbs, std::size_t length) {
+  while (length > 0 && limbs[length - 1] == 0) {
+    --length;
+  }
+  return length;
+}
+
+inline void mulSchoolbook(const u64* a, std::size_t aLength, const u64* b, std::size_t bLength, u64* out) {
+  for (std::size_t i = 0; i < bLength; ++i) {
+    u64 carry = 0;
+    for (std::size_t j = 0; j < aLength; ++j) {
+      out[i + j] = mulAdd(a[j], b[i], out[i + j], carry);
+    }
+    out[i + aLength] = carry;
+  }
+}
+
+/// out[0..aLength + bLength) = a * b, with out zeroed on entry. Operands a lot longer
+/// than the other go through in slices of the shorter one's length, so every Karatsuba
+/// split is close to balanced.
+inline void mulKaratsuba(const u64* a, std::size_t aLength, const u64* b, std::size_t bLength, u64* out) {
+  if (aLength < bLength) {
+    std::swap(a, b);
+    std::swap(aLength, bLength);
+  }
+  if (bLength < kKaratsubaLimbs) {
+    mulSchoolbook(a, aLength, b, bLength, out);
+    return;
+  }
+
+  const std::size_t outLength = aLength + bLength;
+  if (aLength >= 2 * bLength) {
+    LimbVector slice(2 * bLength);
+    for (std::size_t at = 0; at < aLength; at += bLength) {
+      const std::size_t sliceLength = std::min(bLength, aLength - at);
+      std::fill(slice.begin(), slice.end(), 0);
+      mulKaratsuba(a + at, sliceLength, b, bLength, slice.data());
+      addInto(out + at, outLength - at, slice.data(), sliceLength + bLength);
+    }
+    return;
+  }
+
+  // a = a1 * B^half + a0 and b = b1 * B^half + b0. b1 is never empty, since b is more
+  // than half of a. a0 * b0 and a1 * b1 go straight into the two ends of out.
+  const std::size_t half = aLength / 2;
+  const std::size_t aHigh = aLength - half;
+  const std::size_t bHigh = bLength - half;
+  mulKaratsuba(a, half, b, half, out);
+  mulKaratsuba(a + half, aHigh, b + half, bHigh, out + 2 * half);
+
+  LimbVector aSum(aHigh + 1);
+  LimbVector bSum(std::max(half, bHigh) + 1);
+  std::copy(a + half, a + aLength, aSum.begin());
+  addInto(aSum.data(), aSum.size(), a, half);
+  std::copy(b, b + half, bSum.begin());
+  addInto(bSum.data(), bSum.size(), b + half, bHigh);
+
+  // (a0 + a1)(b0 + b1) - a0 * b0 - a1 * b1 is the middle term
+  LimbVector middle(aSum.size() + bSum.size());
+  mulKaratsuba(aSum.data(), significantLimbs(aSum.data(), aSum.size()), bSum.data(),
+               significantLimbs(bSum.data(), bSum.size()), middle.data());
+  subtractFrom(middle.data(), middle.size(), out, 2 * half);
+  subtractFrom(middle.data(), middle.size(), out + 2 * half, aHigh + bHigh);
+  addInto(out + half, outLength - half, middle.data(), significantLimbs(middle.data(), middle.size()));
+}
+
+inline LimbVector mulVector(const LimbVector& a, const LimbVector& b) {
+  LimbVector product(a.size() + b.size());
+  mulKaratsuba(a.data(), a.size(), b.data(), b.size(), product.data());
+  product.resize(significantLimbs(product.data(), product.size()));
+  return product;
+}
+
+/// chunks[0..count), most significant first, as one number in base 10^19. powers[k]
+/// is 10^(19 * 2^k), filled in as far as count needs.
+inline LimbVector convertChunks(const u64* chunks, std::size_t count, const std::vector<LimbVector>& powers) {
+  if (count <= kHornerChunks) {
+    LimbVector value;
+    value.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      u64 carry = chunks[i];
+      for (u64& limb : value) {
+        limb = mulAdd(limb, kChunkPower, 0, carry);
+      }
+      if (carry != 0) {
+        value.push_back(carry);
+      }
+    }
+    return value;
+  }
+
+  std::size_t k = 0;
+  while ((std::size_t{2} << k) < count) {
+    ++k;
+  }
+  const std::size_t low = std::size_t{1} << k;
+  LimbVector value = mulVector(convertChunks(chunks, count - low, powers), powers[k]);
+  const LimbVector lowValue = convertChunks(chunks + count - low, low, powers);
+  value.resize(std::max(value.size(), lowValue.size()) + 1);
+  addInto(value.data(), value.size(), lowValue.data(), lowValue.size());
+  value.resize(significantLimbs(value.data(), value.size()));
+  return value;
+}
+
+/// The powers convertChunks() needs for count chunks. Squaring up to the top one costs
+/// about what the top split's multiply does, so they're kept per thread and reused.
+inline const std::vector<LimbVector>& chunkPowers(std::size_t count) {
+  static thread_local std::vector<LimbVector> powers(1, LimbVector(1, kChunkPower));
+  while ((std::size_t{2} << (powers.size() - 1)) < count) {
+    powers.push_back(mulVector(powers.back(), powers.back()));
+  }
+  return powers;
+}
+
+/// Cuts digits into 19 digit chunks, the first one short, and parses each with the
+/// dispatched decimal kernel.
+inline intparse::ParseError parseChunks(const intparse::KernelTable& table, const char* digits,
+                                        std::size_t length, std::vector<u64>& chunks) {
+  chunks.resize((length + kChunkDigits - 1) / kChunkDigits);
+  std::size_t width = length - (chunks.size() - 1) * kChunkDigits;
+  for (u64& chunk : chunks) {
+    if (table.parseDecimal(digits, width, chunk) != intparse::ParseError::None) {
+      return intparse::ParseError::InvalidDigit;  // 19 digits can't overflow
+    }
+    digits += width;
+    width = kChunkDigits;
+  }
+  return intparse::ParseError::None;
+}
+
+}  // namespace detail
+
+/// Parses decimal digits of any length into limbs, least significant first, with no
+/// zero limbs on top, so zero comes out empty.
+inline intparse::ParseError parseDecimal(const char* digits, std::size_t length, LimbVector& limbs) {
+  using intparse::ParseError;
+  const intparse::KernelTable& table = intparse::activeKernels();
+  const intparse::Isa isa = table.isa[static_cast<std::size_t>(intparse::KernelOp::ParseDecimal)];
+  limbs.clear();
+  if (length == 0) {
+    intparse::detail::recordParse(isa, length, ParseError::Empty);
+    return ParseError::Empty;
+  }
+
+  std::vector<u64> chunks;
+  const ParseError error = detail::parseChunks(table, digits, length, chunks);
+  if (error == ParseError::None) {
+    limbs = detail::convertChunks(chunks.data(), chunks.size(), detail::chunkPowers(chunks.size()));
+  }
+  intparse::detail::recordParse(isa, length, error);
+  return error;
+}
+
+/// Parses decimal digits into a Limbs<N>, for up to about 19 * N digits, Overflow past
+/// that. At these lengths the chunks fold in one at a time.
+template <std::size_t kLimbs>
+inline intparse::ParseError parseDecimal(const char* digits, std::size_t length, Limbs<kLimbs>& value) {
+  using intparse::ParseError;
+  const intparse::KernelTable& table = intparse::activeKernels();
+  const intparse::Isa isa = table.isa[static_cast<std::size_t>(intparse::KernelOp::ParseDecimal)];
+  value = Limbs<kLimbs>{};
+  if (length == 0) {
+    intparse::detail::recordParse(isa, length, ParseError::Empty);
+    return ParseError::Empty;
+  }
+
+  // An invalid digit anywhere wins over overflow, as with the single limb kernels
+  ParseError error = ParseError::None;
+  std::size_t width = length - (length - 1) / detail::kChunkDigits * detail::kChunkDigits;
+  for (std::size_t at = 0; at < length; at += width, width = detail::kChunkDigits) {
+    u64 carry = 0;
+    if (table.parseDecimal(digits + at, width, carry) != ParseError::None) {
+      error = ParseError::InvalidDigit;
+      break;
+    }
+    detail::unroll<kLimbs>([&](auto j) { value[j] = detail::mulAdd(value[j], detail::kChunkPower, 0, carry); });
+    error = carry != 0 ? ParseError::Overflow : error;
+  }
+  intparse::detail::recordParse(isa, length, error);
+  return error;
+}
+
+}  // namespace wideint
+
+namespace intliterals {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+/// The wide literal's digits, folded into limbs by multiplying through by the radix.
+template <std::size_t kLimbs>
+struct WideValue {
+  wideint::Limbs<kLimbs> value = {};
+  bool fits = true;
+};
+
+template <std::size_t kLimbs, char... kChars>
+constexpr WideValue<kLimbs> parseWideValue() {
+  const char text[] = {kChars...};
+  const std::size_t length = sizeof...(kChars);
+  unsigned radix = 10;
+  std::size_t at = 0;
+  if (length > 1 && text[0] == '0') {
+    const char prefix = static_cast<char>(text[1] | 0x20);
+    radix = prefix == 'x' ? 16 : prefix == 'b' ? 2 : 8;
+    at = radix == 8 ? 1 : 2;
+  }
+
+  WideValue<kLimbs> result;
+  for (; at < length; ++at) {
+    u64 carry = digitToValue(text[at]);
+    for (std::size_t i = 0; i < kLimbs; ++i) {
+      result.value[i] = wideint::detail::mulAdd(result.value[i], radix, 0, carry);
+    }
+    result.fits = result.fits && carry == 0;
+  }
+  return result;
+}
+
+}  // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////
+/// The wide operators, one per limb count.
+#define SCW_FIXEDWIDTH_DEFINE_WIDE_OPERATOR(typesuffix_, limbs_, errorMessage_)             \
+  template <char... kChars>                                                                \
+  constexpr wideint::Limbs<limbs_> operator"" typesuffix_() {                              \
+    constexpr detail::WideValue<limbs_> kParsed = detail::parseWideValue<limbs_, kChars...>(); \
+    static_assert(kParsed.fits, errorMessage_);                                            \
+    return kParsed.value;                                                                  \
+  }
+
+// clang-format off
+SCW_FIXEDWIDTH_DEFINE_WIDE_OPERATOR(_w128, 2, "w128 literal doesn't fit in 128 bits.");
+SCW_FIXEDWIDTH_DEFINE_WIDE_OPERATOR(_w192, 3, "w192 literal doesn't fit in 192 bits.");
+SCW_FIXEDWIDTH_DEFINE_WIDE_OPERATOR(_w256, 4, "w256 literal doesn't fit in 256 bits.");
+SCW_FIXEDWIDTH_DEFINE_WIDE_OPERATOR(_w320, 5, "w320 literal doesn't fit in 320 bits.");
+SCW_FIXEDWIDTH_DEFINE_WIDE_OPERATOR(_w384, 6, "w384 literal doesn't fit in 384 bits.");
+SCW_FIXEDWIDTH_DEFINE_WIDE_OPERATOR(_w448, 7, "w448 literal doesn't fit in 448 bits.");
+SCW_FIXEDWIDTH_DEFINE_WIDE_OPERATOR(_w512, 8, "w512 literal doesn't fit in 512 bits.");
+// clang-format on
+
+}  // namespace intliterals
+}  // namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE
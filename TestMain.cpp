@@ -22,6 +22,7 @@
 #endif
 
 #include "FixedWidthIntLiterals.h"
+#include "FixedWidthTickLiterals.h"
 
 using namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::intliterals;
 
@@ -34,6 +35,14 @@ int main(int argc, char* argv[]) {
 //    constexpr auto dec1 = 257_u8;
 //    constexpr auto hex1 = 0xff01_u8;
 //    constexpr auto hex1 = 0xffff12345_u32;
+//    constexpr auto dec2 = 18446744073709551616_u64;
+//    constexpr auto oct2 = 02000000000000000000000_u64;
+//    constexpr auto dec3 = 19.999_d2;
+//    constexpr auto dec4 = 1e3_d2;
+//    constexpr auto dec5 = 010_d2;
+//    constexpr auto dec6 = 92233720368547758.08_d2;
+//    constexpr auto tick1 = 65536_ms16;
+//    constexpr auto tick2 = 4294967296_us32;
   }
 
   {
@@ -123,6 +132,88 @@ int main(int argc, char* argv[]) {
     static_assert(std::is_same<const uint16_t, decltype(x16)>::value, "Broken");
   }
 
+  {
+    // Repeated spellings read the same memoized value
+    constexpr auto sz1 = 4096_z;
+    constexpr auto sz2 = 4096_z;
+    constexpr auto hex1 = 0xff_u8;
+    static_assert(sz1 == sz2 && sz1 == 4096u, "xxx");
+    static_assert(hex1 == 0xff_u8 && hex1 == 255u, "xxx");
+    static_assert(std::is_same<const size_t, decltype(sz2)>::value, "Broken");
+  }
+
+  {
+    constexpr auto price = 19.99_d2;
+    constexpr auto rate = 1.2345_d4;
+    constexpr auto sat = 0.00000001_d8;
+
+    static_assert(price == 1999, "xxx");
+    static_assert(rate == 12345, "xxx");
+    static_assert(sat == 1, "xxx");
+    static_assert(-19.99_d2 == -1999 && 5_d2 == 500 && 0.5_d2 == 50 && .5_d2 == 50 && 5._d2 == 500, "xxx");
+    static_assert(0.1_d6 == 100000 && 0_d8 == 0 && 0.0_d2 == 0, "xxx");
+    static_assert(92233720368547758.07_d2 == INT64_MAX && 92233720368.54775807_d8 == INT64_MAX, "xxx");
+    static_assert(std::is_same<const int64_t, decltype(price)>::value, "Broken");
+  }
+
+  {
+    constexpr auto delta = 1500_us32;
+    constexpr auto budget = 250_ms16;
+    constexpr auto stamp = 123456789012_ns64;
+
+    static_assert(sizeof(delta) == 4 && sizeof(budget) == 2 && sizeof(stamp) == 8, "Broken");
+    static_assert(std::is_same<const TicksUs32, decltype(delta)>::value, "Broken");
+    static_assert(std::is_same<const TicksMs16, decltype(budget)>::value, "Broken");
+    static_assert(std::is_same<const TicksNs64, decltype(stamp)>::value, "Broken");
+    static_assert(delta.count() == 1500 && budget.count() == 250 && (65535_ms16).count() == 65535, "xxx");
+
+    // Mixed units compare in the finer unit, the coarse literal scaled at compile time
+    static_assert(compareTicks(delta, budget) < 0 && compareTicks(1_ms16, delta) < 0, "xxx");
+    static_assert(compareTicks(1500_us32, 1500000_ns64) == 0 && compareTicks(delta, delta) == 0, "xxx");
+    static_assert(compareTicks(1_ms16, 20000_ns16) > 0 && compareTicks(5_s16, 4000000000_ns32) > 0, "xxx");
+    static_assert(compareTicks(4000000000_ns32, 5_s16) < 0 && compareTicks(65535_s16, 65535_ms64) > 0, "xxx");
+    static_assert(compareTicks(1_s64, 1000000001_ns32) < 0 && compareTicks(1_s64, 1000000000_ns32) == 0, "xxx");
+    static_assert(compareTicks(18446744073709551615_s64, 18446744073709551615_ns64) > 0, "xxx");
+    static_assert(compareTicks(1_us16, 1000_ns16) == 0, "xxx");
+    static_assert(std::chrono::duration_cast<TicksMs16>(delta) == 1_ms16, "xxx");
+    static_assert(std::chrono::duration_cast<TicksUs32>(budget).count() == 250000, "xxx");
+    static_assert(TicksNs64(3_us32).count() == 3000 && TicksMs64(2_s16).count() == 2000, "xxx");
+  }
+
+  {
+    // The largest 64-bit value in every base, with leading zeros past the width of the type
+    static_assert(18446744073709551615_u64 == UINT64_MAX, "xxx");
+    static_assert(01777777777777777777777_u64 == UINT64_MAX, "xxx");
+    static_assert(0xffffffffffffffff_u64 == UINT64_MAX, "xxx");
+    static_assert(0b1111111111111111111111111111111111111111111111111111111111111111_u64 == UINT64_MAX, "xxx");
+    static_assert(0000000000000000000000000000000000042_u64 == 042u, "xxx");
+    static_assert(0x000000000000000000000001_u64 == 1u, "xxx");
+    static_assert(9999999999999999999_u64 == UINT64_C(9999999999999999999), "xxx");
+  }
+
+  {
+    using Powers10 = SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::RadixPowers<uint64_t, 10>;
+    using Powers8 = SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::RadixPowers<uint64_t, 8>;
+    using Powers16 = SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::RadixPowers<uint64_t, 16>;
+    using Powers2 = SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::RadixPowers<uint64_t, 2>;
+    static_assert(Powers10::kDigits == 20 && Powers10::kSafeDigits == 19, "xxx");
+    static_assert(Powers8::kDigits == 22 && Powers8::kSafeDigits == 21, "xxx");
+    static_assert(Powers16::kDigits == 16 && Powers16::kSafeDigits == 16, "xxx");
+    static_assert(Powers2::kDigits == 64 && Powers2::kSafeDigits == 64, "xxx");
+    static_assert(Powers10::kPower[19] == UINT64_C(10000000000000000000), "xxx");
+    static_assert(Powers2::kPower[63] == UINT64_C(1) << 63, "xxx");
+    static_assert(Powers10::fits(1844, UINT64_C(6744073709551615), 16), "xxx");
+    static_assert(!Powers10::fits(1844, UINT64_C(6744073709551616), 16), "xxx");
+    static_assert(!Powers10::fits(1845, 0, 16), "xxx");
+    static_assert(Powers16::fits(0, 0, 16) && !Powers16::fits(1, 0, 16), "xxx");
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 u128;
+    using Powers10x128 = SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::RadixPowers<u128, 10>;
+    static_assert(Powers10x128::kDigits == 39 && Powers10x128::kSafeDigits == 38, "xxx");
+    static_assert(Powers10x128::kPower[38] / Powers10x128::kPower[19] == Powers10x128::kPower[19], "xxx");
+#endif
+  }
+
   {
     static_assert(0b1110101_i32 == INT32_C(0b1110101), "xxx");
     static_assert(0xffeeffdd0012345_u64 == UINT64_C(0xffeeffdd0012345), "xxx");
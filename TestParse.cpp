@@ -0,0 +1,1075 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE
+#define SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE scw
+#endif
+
+#include "FixedWidthIntParse.h"
+
+#include <arpa/inet.h>
+
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::intparse;
+
+namespace {
+
+int gFailures = 0;
+const char* gContext = "";
+
+void check(bool ok, const char* what, int line) {
+  if (!ok) {
+    std::fprintf(stderr, "TestParse.cpp:%d: [%s] check failed: %s\n", line, gContext, what);
+    ++gFailures;
+  }
+}
+
+#define CHECK(cond_) check((cond_), #cond_, __LINE__)
+
+std::string decimalText(u64 value) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(value));
+  return buffer;
+}
+
+std::string hexText(u64 value) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%llx", static_cast<unsigned long long>(value));
+  return buffer;
+}
+
+std::string binaryText(u64 value) {
+  std::string text;
+  do {
+    text.insert(text.begin(), static_cast<char>('0' + (value & 1)));
+    value >>= 1;
+  } while (value != 0);
+  return text;
+}
+
+ParseError parse(ParseKernel kernel, const std::string& text, u64& value) {
+  return kernel(text.data(), text.size(), value);
+}
+
+std::vector<u64> interestingValues() {
+  std::vector<u64> values = {0, 1, 9, 10, 15, 16, 255, 256, ~u64{0}, ~u64{0} - 1, u64{1} << 63};
+  u64 power = 1;
+  for (int i = 0; i < 19; ++i) {
+    power *= 10;
+    values.push_back(power - 1);
+    values.push_back(power);
+    values.push_back(power + 1);
+  }
+  for (int bit = 0; bit < 64; ++bit) {
+    values.push_back((u64{1} << bit) - 1);
+    values.push_back(u64{1} << bit);
+  }
+  std::mt19937_64 rng(2018);
+  for (int i = 0; i < 2000; ++i) {
+    values.push_back(rng() >> (rng() % 64));
+  }
+  return values;
+}
+
+void testTable(const KernelTable& table) {
+  gContext = isaName(table.limit);
+  for (u64 expected : interestingValues()) {
+    char buffer[kMaxDecimalChars + 1] = {};
+    u64 value = 0;
+
+    CHECK(std::string(buffer, table.formatDecimal(expected, buffer)) == decimalText(expected));
+    CHECK(parse(table.parseDecimal, decimalText(expected), value) == ParseError::None && value == expected);
+    CHECK(std::string(buffer, table.formatHex(expected, buffer)) == hexText(expected));
+    CHECK(parse(table.parseHex, hexText(expected), value) == ParseError::None && value == expected);
+    CHECK(parse(table.parseBinary, binaryText(expected), value) == ParseError::None && value == expected);
+
+    // Leading zeros are just more digits
+    CHECK(parse(table.parseDecimal, "0000" + decimalText(expected), value) == ParseError::None &&
+          value == expected);
+    CHECK(parse(table.parseHex, "000000000" + hexText(expected), value) == ParseError::None && value == expected);
+    CHECK(parse(table.parseBinary, "00000000000000000" + binaryText(expected), value) == ParseError::None &&
+          value == expected);
+  }
+
+  // Upper case hex parses, but the formatter sticks to lower case
+  u64 value = 0;
+  CHECK(parse(table.parseHex, "DEADbeefCAFE0123", value) == ParseError::None && value == 0xdeadbeefcafe0123u);
+
+  // A bad character anywhere in any length of token is caught
+  const char kBadChars[] = {'/', ':', ' ', 'g', 'G', '@', '`', '-', '\x10', '\x80', '\xb0'};
+  for (std::size_t length = 1; length <= 64; ++length) {
+    for (std::size_t at = 0; at < length; ++at) {
+      for (char bad : kBadChars) {
+        std::string text(length, '1');
+        text[at] = bad;
+        CHECK(parse(table.parseDecimal, text, value) == ParseError::InvalidDigit);
+        CHECK(parse(table.parseHex, text, value) == ParseError::InvalidDigit);
+        CHECK(parse(table.parseBinary, text, value) == ParseError::InvalidDigit);
+        text.insert(0, 40, '0');
+        CHECK(parse(table.parseDecimal, text, value) == ParseError::InvalidDigit);
+      }
+    }
+  }
+
+  // Overflow is by value, not by length
+  CHECK(parse(table.parseDecimal, "18446744073709551616", value) == ParseError::Overflow);
+  CHECK(parse(table.parseDecimal, "99999999999999999999", value) == ParseError::Overflow);
+  CHECK(parse(table.parseDecimal, "100000000000000000000", value) == ParseError::Overflow);
+  CHECK(parse(table.parseDecimal, "28446744073709551615", value) == ParseError::Overflow);
+  CHECK(parse(table.parseHex, "10000000000000000", value) == ParseError::Overflow);
+  CHECK(parse(table.parseBinary, std::string(65, '1'), value) == ParseError::Overflow);
+  CHECK(parse(table.parseBinary, "1" + std::string(64, '0'), value) == ParseError::Overflow);
+  CHECK(parse(table.parseDecimal, std::string(30, '9') + "x", value) == ParseError::InvalidDigit);
+
+  CHECK(parse(table.parseDecimal, "", value) == ParseError::Empty);
+  CHECK(parse(table.parseHex, "", value) == ParseError::Empty);
+  CHECK(parse(table.parseBinary, "", value) == ParseError::Empty);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Address text against inet_pton and inet_ntop: the same verdict on every string,
+/// the same address when it's valid, and the same text back out.
+std::string mutate(std::string text, std::mt19937_64& rng) {
+  static const char kChars[] = "0123456789abcdefABCDEF:.:.g/ 0";
+  const char ch = kChars[rng() % (sizeof(kChars) - 1)];
+  const std::size_t at = text.empty() ? 0 : rng() % text.size();
+  switch (rng() % 4) {
+    case 0: text.insert(text.begin() + static_cast<std::ptrdiff_t>(at), ch); break;
+    case 1:
+      if (!text.empty()) {
+        text.erase(at, 1);
+      }
+      break;
+    default:
+      if (!text.empty()) {
+        text[at] = ch;
+      }
+      break;
+  }
+  return text;
+}
+
+Ipv6Address randomIpv6(std::mt19937_64& rng) {
+  // Mostly zero hextets, so there are runs of every length to compress
+  Ipv6Address address;
+  for (std::size_t i = 0; i < 16; i += 2) {
+    const unsigned word = rng() % 3 == 0 ? static_cast<unsigned>(rng() >> (rng() % 64)) : 0;
+    address.bytes[i] = static_cast<std::uint8_t>(word >> 8);
+    address.bytes[i + 1] = static_cast<std::uint8_t>(word);
+  }
+  if (rng() % 8 == 0) {
+    std::memset(address.bytes, 0, 10);
+    address.bytes[10] = address.bytes[11] = 0xff;  // IPv4-mapped
+  }
+  return address;
+}
+
+void testAddresses(const KernelTable& table) {
+  gContext = isaName(table.limit);
+  std::mt19937_64 rng(89);
+  const char* const kFixed[] = {"0.0.0.0", "255.255.255.255", "1.2.3.4", "256.1.1.1", "1.2.3.999", "01.2.3.4",
+                                "1.2.3", "1.2.3.4.", ".1.2.3.4", "1..3.4", "1.2.3.4.5", "1234.1.1.1", "",
+                                "::", "::1", "1::", ":", ":::", "1:::2", "::1::2", "1:2:3:4:5:6:7:8",
+                                "1:2:3:4:5:6:7:8:9", "1:2:3:4:5:6:7::", "::2:3:4:5:6:7:8", "1:2:3:4:5:6:7::8",
+                                "1:2:3:4:5:6:7:", ":1:2:3:4:5:6:7", "12345::", "ABCD:ef01::", "::ffff:1.2.3.4",
+                                "::1.2.3.4", "1:2:3:4:5:6:1.2.3.4", "1:2:3:4:5:6:7:1.2.3.4", "::1.2.3.04",
+                                "::1.2.3", "::1.2.3.4:5", "1.2.3.4::", "::ffff:256.1.1.1", "fe80::1%eth0",
+                                "0000:0000:0000:0000:0000:0000:0000:0000", "00000::"};
+  std::vector<std::string> texts(std::begin(kFixed), std::end(kFixed));
+  for (int i = 0; i < 4000; ++i) {
+    char text[INET6_ADDRSTRLEN];
+    const std::uint32_t address = static_cast<std::uint32_t>(rng() >> (rng() % 32));
+    const Ipv6Address address6 = randomIpv6(rng);
+    texts.push_back(inet_ntop(AF_INET, &address, text, sizeof(text)));
+    texts.push_back(mutate(texts.back(), rng));
+    texts.push_back(inet_ntop(AF_INET6, address6.bytes, text, sizeof(text)));
+    texts.push_back(mutate(texts.back(), rng));
+    texts.push_back(mutate(texts.back(), rng));
+
+    char buffer[kMaxIpv6Chars] = {};
+    CHECK(std::string(buffer, formatIpv4(address, buffer)) == inet_ntop(AF_INET, &address, text, sizeof(text)));
+    CHECK(std::string(buffer, formatIpv6(address6, buffer)) ==
+          inet_ntop(AF_INET6, address6.bytes, text, sizeof(text)));
+  }
+
+  for (const std::string& text : texts) {
+    std::uint32_t expected = 0;
+    std::uint32_t address = 0;
+    const bool valid = inet_pton(AF_INET, text.c_str(), &expected) == 1;
+    const ParseError error = table.parseIpv4(text.data(), text.size(), address);
+    CHECK((error == ParseError::None) == valid);
+    CHECK(!valid || address == expected);
+    CHECK(text.empty() == (error == ParseError::Empty));
+
+    Ipv6Address expected6 = {};
+    Ipv6Address address6 = {};
+    const bool valid6 = inet_pton(AF_INET6, text.c_str(), expected6.bytes) == 1;
+    const ParseError error6 = table.parseIpv6(text.data(), text.size(), address6);
+    CHECK((error6 == ParseError::None) == valid6);
+    CHECK(!valid6 || address6 == expected6);
+    if ((error == ParseError::None) != valid || (error6 == ParseError::None) != valid6) {
+      std::fprintf(stderr, "  text \"%s\"\n", text.c_str());
+    }
+  }
+
+  std::uint32_t address = 0;
+  CHECK(table.parseIpv4("1.2.3.256", 9, address) == ParseError::Overflow);
+  CHECK(table.parseIpv4("999.2.3.4", 9, address) == ParseError::Overflow);
+  CHECK(table.parseIpv4("1.2.3.x", 7, address) == ParseError::InvalidDigit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// UUIDs against snprintf, and a hyphen or digit out of place anywhere is caught.
+void testUuids(const KernelTable& table) {
+  gContext = isaName(table.limit);
+  std::mt19937_64 rng(90);
+  for (int i = 0; i < 2000; ++i) {
+    const Uuid expected{rng() >> (rng() % 64), i % 7 == 0 ? ~u64{0} : rng()};
+    char text[kUuidChars + 1];
+    std::snprintf(text, sizeof(text), "%08llx-%04llx-%04llx-%04llx-%012llx",
+                  static_cast<unsigned long long>(expected.high >> 32),
+                  static_cast<unsigned long long>((expected.high >> 16) & 0xffff),
+                  static_cast<unsigned long long>(expected.high & 0xffff),
+                  static_cast<unsigned long long>(expected.low >> 48),
+                  static_cast<unsigned long long>(expected.low & 0xffffffffffffu));
+
+    char buffer[kUuidChars] = {};
+    table.formatUuid(expected, buffer);
+    CHECK(std::string(buffer, kUuidChars) == text);
+    Uuid uuid = {0, 0};
+    CHECK(table.parseUuid(text, kUuidChars, uuid) == ParseError::None && uuid == expected);
+    for (char& ch : text) {
+      ch = rng() % 2 == 0 ? static_cast<char>(std::toupper(ch)) : ch;
+    }
+    CHECK(table.parseUuid(text, kUuidChars, uuid) == ParseError::None && uuid == expected);
+
+    std::string bad(text, kUuidChars);
+    const std::size_t at = rng() % kUuidChars;
+    const char kBadChars[] = {'-', 'g', 'G', '/', ':', '@', '`', ' ', '\0', '\x80', '0'};
+    bad[at] = kBadChars[rng() % sizeof(kBadChars)];
+    const bool hyphen = at == 8 || at == 13 || at == 18 || at == 23;
+    const bool stillValid = bad[at] == (hyphen ? '-' : '0');
+    CHECK((table.parseUuid(bad.data(), kUuidChars, uuid) == ParseError::None) == stillValid);
+  }
+
+  Uuid uuid = {0, 0};
+  const char* const kText = "123e4567-e89b-12d3-a456-426614174000";
+  CHECK(table.parseUuid(kText, kUuidChars, uuid) == ParseError::None);
+  CHECK(uuid.high == 0x123e4567e89b12d3u && uuid.low == 0xa456426614174000u);
+  CHECK(table.parseUuid(kText, kUuidChars - 1, uuid) == ParseError::InvalidDigit);
+  CHECK(table.parseUuid("123e4567e89b12d3a456426614174000", 32, uuid) == ParseError::InvalidDigit);
+  CHECK(table.parseUuid("123e4567-e89b-12d3-a456-42661417400-", kUuidChars, uuid) == ParseError::InvalidDigit);
+  CHECK(table.parseUuid("123e4567-e89b-12d3-a456-4266141740000", kUuidChars + 1, uuid) == ParseError::InvalidDigit);
+  CHECK(table.parseUuid("", 0, uuid) == ParseError::Empty);
+  CHECK(UuidHash()(uuid) != UuidHash()(Uuid{uuid.low, uuid.high}));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch parsing: the rows kernel against the scalar kernel row by row, then the batch
+/// entry point against single token parses and the type's bound.
+std::vector<std::string> batchTokens(std::mt19937_64& rng) {
+  std::vector<std::string> tokens = {"0", "255", "256", "65535", "65536", "127", "128", "4294967295",
+                                     "4294967296", "9223372036854775807", "9223372036854775808",
+                                     "18446744073709551615", "18446744073709551616", "", "00000000000000000000255",
+                                     "9999999999999999", "0000000000000000", "1x", "x", "12 ", "-1", "+1"};
+  for (u64 value : interestingValues()) {
+    tokens.push_back(decimalText(value));
+  }
+  for (int i = 0; i < 2000; ++i) {
+    std::string text = decimalText(rng() >> (rng() % 64)).substr(0, 1 + rng() % 20);
+    if (rng() % 8 == 0) {
+      text[rng() % text.size()] = static_cast<char>(rng());
+    }
+    tokens.push_back(text);
+  }
+  return tokens;
+}
+
+template <typename T>
+void testBatchType(const std::vector<std::string>& tokens) {
+  std::vector<T> values(tokens.size(), T(1));
+  std::vector<ParseError> errors(tokens.size());
+  std::size_t expectedParsed = 0;
+  const std::size_t parsed = parseDecimalBatch(tokens.data(), tokens.size(), values.data(), errors.data());
+  for (std::size_t i = 0; i < tokens.size(); ++i) {
+    u64 value = 0;
+    ParseError expected = parseDecimal(tokens[i].data(), tokens[i].size(), value);
+    if (expected == ParseError::None && value > static_cast<u64>(std::numeric_limits<T>::max())) {
+      expected = ParseError::Overflow;
+    }
+    expectedParsed += expected == ParseError::None ? 1 : 0;
+    CHECK(errors[i] == expected);
+    CHECK(values[i] == (expected == ParseError::None ? static_cast<T>(value) : T(0)));
+  }
+  CHECK(parsed == expectedParsed);
+}
+
+void testBatch(const KernelTable& table) {
+  gContext = isaName(table.isa[static_cast<std::size_t>(KernelOp::ParseDecimalBatch)]);
+  std::mt19937_64 rng(94);
+  const std::vector<std::string> tokens = batchTokens(rng);
+  alignas(32) char rows[kBatchRows][kBatchRowChars];
+  for (std::size_t base = 0; base < tokens.size(); base += kBatchRows) {
+    const std::size_t count = std::min(kBatchRows, tokens.size() - base);
+    std::memset(rows, '0', sizeof(rows));
+    for (std::size_t i = 0; i < count; ++i) {
+      const std::string& token = tokens[base + i];
+      const std::size_t length = std::min(token.size(), kBatchRowChars);
+      std::memcpy(rows[i] + kBatchRowChars - length, token.data(), length);
+    }
+    u64 values[kBatchRows];
+    const unsigned invalid = table.parseDecimalRows(rows, count, values);
+    for (std::size_t i = 0; i < count; ++i) {
+      u64 expected = 0;
+      const bool valid = detail::parseScalar<10>(rows[i], kBatchRowChars, expected) == ParseError::None;
+      CHECK((invalid >> i & 1) == (valid ? 0u : 1u));
+      CHECK(!valid || values[i] == expected);
+    }
+    CHECK(invalid >> count == 0);
+  }
+
+  // The filters, against the scalar kernels, with bounds right at the values and at the ends
+  for (int trial = 0; trial < 1000; ++trial) {
+    u64 values[kBatchRows];
+    for (u64& value : values) {
+      value = rng() % 4 == 0 ? ~u64{0} - rng() % 3 : rng() >> (rng() % 64);
+    }
+    const u64 lowest = trial % 5 == 0 ? 0 : values[rng() % kBatchRows] - rng() % 2;
+    const u64 span = trial % 7 == 0 ? ~u64{0} : rng() >> (rng() % 64);
+    const u64 mask = trial % 3 == 0 ? ~u64{0} : rng() >> (rng() % 64);
+    const u64 expected = values[rng() % kBatchRows] & (trial % 2 == 0 ? mask : ~u64{0});
+    CHECK(table.matchRange(values, lowest, span) == detail::matchRangeScalar(values, lowest, span));
+    CHECK(table.matchMasked(values, mask, expected) == detail::matchMaskedScalar(values, mask, expected));
+  }
+
+  if (&table == &activeKernels()) {
+    testBatchType<std::uint8_t>(tokens);
+    testBatchType<std::uint16_t>(tokens);
+    testBatchType<std::uint32_t>(tokens);
+    testBatchType<std::uint64_t>(tokens);
+    testBatchType<std::int8_t>(tokens);
+    testBatchType<std::int16_t>(tokens);
+    testBatchType<std::int32_t>(tokens);
+    testBatchType<std::int64_t>(tokens);
+    testBatchType<std::size_t>(tokens);
+
+    std::uint8_t values[3] = {7, 7, 7};
+    ParseError errors[3];
+    const std::string few[] = {"200", "300", "1"};
+    CHECK(parseDecimalBatch(few, 3, values, errors) == 2);
+    CHECK(values[0] == 200 && values[1] == 0 && values[2] == 1 && errors[1] == ParseError::Overflow);
+    CHECK(parseDecimalBatch(few, 0, values, errors) == 0);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Parse and reduce against parsing every token and reducing by hand.
+template <typename T>
+void testReduceType(const std::string& column, const std::vector<u64>& values) {
+  SumReducer<T> sum;
+  MinReducer<T> min;
+  MaxReducer<T> max;
+  CountReducer count;
+  HistogramReducer<T, 8> histogram(10, 25);
+  const ReduceResult result = parseReduce<T>(column.data(), column.size(), '\n', sum);
+  parseReduce<T>(column.data(), column.size(), '\n', min);
+  parseReduce<T>(column.data(), column.size(), '\n', max);
+  parseReduce<T>(column.data(), column.size(), '\n', count);
+  parseReduce<T>(column.data(), column.size(), '\n', histogram);
+
+  u64 expectedSum = 0;
+  bool overflow = false;
+  u64 expectedMin = static_cast<u64>(std::numeric_limits<T>::max());
+  u64 expectedMax = 0;
+  std::size_t buckets[8] = {};
+  for (u64 value : values) {
+    overflow = overflow || value > static_cast<u64>(std::numeric_limits<T>::max()) - expectedSum;
+    expectedSum = overflow ? static_cast<u64>(std::numeric_limits<T>::max()) : expectedSum + value;
+    expectedMin = std::min(expectedMin, value);
+    expectedMax = std::max(expectedMax, value);
+    ++buckets[value < 10 ? 0 : std::min<u64>((value - 10) / 25, 7)];
+  }
+  CHECK(result.error == ParseError::None && result.tokens == values.size() && result.offset == column.size());
+  CHECK(sum.overflow == overflow && static_cast<u64>(sum.value) == expectedSum);
+  CHECK(static_cast<u64>(min.value) == expectedMin && static_cast<u64>(max.value) == expectedMax);
+  CHECK(count.count == values.size());
+  CHECK(std::equal(buckets, buckets + 8, histogram.counts));
+}
+
+void testReduce() {
+  gContext = "reduce";
+  std::mt19937_64 rng(95);
+  for (int trial = 0; trial < 50; ++trial) {
+    std::vector<u64> values;
+    std::string column;
+    const std::size_t count = rng() % 100;
+    const unsigned maxBits = trial % 2 == 0 ? 7 : 62;
+    for (std::size_t i = 0; i < count; ++i) {
+      values.push_back(rng() >> (64 - 1 - rng() % maxBits));
+      column += (rng() % 4 == 0 ? "000" : "") + decimalText(values.back()) + "\n";
+    }
+    if (trial % 3 == 0 && !column.empty()) {
+      column.pop_back();  // The last delimiter is optional
+    }
+    if (maxBits == 62) {
+      testReduceType<std::uint64_t>(column, values);
+      testReduceType<std::int64_t>(column, values);
+    } else {
+      testReduceType<std::uint8_t>(column, values);  // Sums of more than a few tokens overflow
+      testReduceType<std::int8_t>(column, values);
+      testReduceType<std::uint32_t>(column, values);
+    }
+  }
+
+  // Stops at the first bad token, with everything before it reduced
+  SumReducer<std::uint8_t> sum;
+  ReduceResult result = parseReduce<std::uint8_t>("1,2,300,4", 9, ',', sum);
+  CHECK(result.error == ParseError::Overflow && result.tokens == 2 && result.offset == 4 && sum.value == 3);
+  CountReducer count;
+  const std::string bad = std::string(40, '1') + ",1x,3";
+  result = parseReduce<std::uint64_t>(bad.data(), bad.size(), ',', count);
+  CHECK(result.error == ParseError::Overflow && result.tokens == 0 && result.offset == 0);
+  result = parseReduce<std::uint64_t>(bad.data() + 41, bad.size() - 41, ',', count);
+  CHECK(result.error == ParseError::InvalidDigit && result.tokens == 0 && result.offset == 0);
+  result = parseReduce<std::uint64_t>("5,,6", 4, ',', count);
+  CHECK(result.error == ParseError::Empty && result.tokens == 1 && result.offset == 2 && count.count == 1);
+  result = parseReduce<std::uint64_t>("", 0, ',', count);
+  CHECK(result.error == ParseError::None && result.tokens == 0 && count.count == 1);
+  std::string many;
+  for (int i = 0; i < 1000; ++i) {
+    many += "65535 ";
+  }
+  SumReducer<std::uint16_t> small;
+  SumReducer<std::uint32_t> large;
+  CHECK(parseReduce<std::uint16_t>(many.data(), many.size(), ' ', small).tokens == 1000 && small.overflow);
+  CHECK(parseReduce<std::uint32_t>(many.data(), many.size(), ' ', large).tokens == 1000 && !large.overflow &&
+        large.value == 65535000u);
+
+  // Offsets from a negative lowest that don't fit a signed T
+  HistogramReducer<std::int64_t, 4> wide(-1, std::numeric_limits<std::int64_t>::max() / 2);
+  wide.add(std::numeric_limits<std::int64_t>::max());
+  wide.add(std::numeric_limits<std::int64_t>::min());
+  wide.add(-1);
+  CHECK(wide.counts[0] == 2 && wide.counts[1] == 0 && wide.counts[2] == 1 && wide.counts[3] == 0);
+  HistogramReducer<std::int8_t, 300> narrow(-128, 1);
+  narrow.add(127);
+  CHECK(narrow.counts[255] == 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Filtered batch parsing against parsing every token and testing it by hand.
+template <typename T, typename Predicate, typename Keep>
+void testSelectType(const std::vector<std::string>& tokens, const Predicate& predicate, Keep keep) {
+  std::vector<T> values(tokens.size());
+  std::vector<std::size_t> rows(tokens.size());
+  std::vector<T> expectedValues;
+  std::vector<std::size_t> expectedRows;
+  std::size_t expectedFailed = 0;
+  for (std::size_t i = 0; i < tokens.size(); ++i) {
+    u64 value = 0;
+    if (parseDecimal(tokens[i].data(), tokens[i].size(), value) != ParseError::None ||
+        value > static_cast<u64>(std::numeric_limits<T>::max())) {
+      ++expectedFailed;
+    } else if (keep(static_cast<T>(value))) {
+      expectedValues.push_back(static_cast<T>(value));
+      expectedRows.push_back(i);
+    }
+  }
+  SelectResult result = parseDecimalSelect(tokens.data(), tokens.size(), predicate, values.data(), rows.data());
+  CHECK(result.selected == expectedValues.size() && result.failed == expectedFailed);
+  CHECK(std::equal(expectedValues.begin(), expectedValues.end(), values.begin()));
+  CHECK(std::equal(expectedRows.begin(), expectedRows.end(), rows.begin()));
+  // Either output can be left out
+  std::fill(rows.begin(), rows.end(), 0);
+  result = parseDecimalSelect(tokens.data(), tokens.size(), predicate, static_cast<T*>(nullptr), rows.data());
+  CHECK(result.selected == expectedRows.size() && std::equal(expectedRows.begin(), expectedRows.end(), rows.begin()));
+  result = parseDecimalSelect(tokens.data(), tokens.size(), predicate, values.data(), nullptr);
+  CHECK(result.selected == expectedValues.size());
+}
+
+/// Keeps values that are multiples of three, to show predicates aren't limited to the built-in ones.
+struct MultipleOfThree {
+  unsigned match(const u64 (&values)[kBatchRows]) const {
+    unsigned mask = 0;
+    for (std::size_t i = 0; i < kBatchRows; ++i) {
+      mask |= static_cast<unsigned>(values[i] % 3 == 0) << i;
+    }
+    return mask;
+  }
+};
+
+void testSelect() {
+  gContext = "select";
+  std::mt19937_64 rng(96);
+  std::vector<std::string> tokens = batchTokens(rng);
+  for (int i = 0; i < 500; ++i) {
+    tokens.push_back(decimalText(rng() % 1000));
+  }
+
+  testSelectType<std::uint64_t>(tokens, RangePredicate<std::uint64_t>(1000000, ~u64{0}),
+                                [](std::uint64_t x) { return x >= 1000000; });
+  testSelectType<std::uint16_t>(tokens, RangePredicate<std::uint16_t>(100, 199),
+                                [](std::uint16_t x) { return x >= 100 && x <= 199; });
+  testSelectType<std::int32_t>(tokens, RangePredicate<std::int32_t>(-5, 10),
+                               [](std::int32_t x) { return x <= 10; });
+  testSelectType<std::int32_t>(tokens, RangePredicate<std::int32_t>(-5, -1), [](std::int32_t) { return false; });
+  testSelectType<std::uint8_t>(tokens, RangePredicate<std::uint8_t>(9, 8), [](std::uint8_t) { return false; });
+  testSelectType<std::uint32_t>(tokens, AnyOfPredicate<std::uint32_t, 3>{{0, 255, 4294967295u}},
+                                [](std::uint32_t x) { return x == 0 || x == 255 || x == 4294967295u; });
+  testSelectType<std::uint64_t>(tokens, BitmaskPredicate<std::uint64_t>{0x5, 0x4},
+                                [](std::uint64_t x) { return (x & 0x5) == 0x4; });
+  testSelectType<std::int64_t>(tokens, MultipleOfThree(), [](std::int64_t x) { return x % 3 == 0; });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Dictionary encoding against parsing every token, with codes handed out in order.
+template <typename T, typename Code>
+void testDictionaryType(const std::vector<std::string>& tokens) {
+  DecimalDictionary<T, Code> dictionary;
+  std::vector<Code> codes(tokens.size(), Code(1));
+  std::vector<ParseError> errors(tokens.size());
+  // In uneven pieces, which has to come out the same as all at once
+  std::size_t encoded = 0;
+  for (std::size_t base = 0, piece = 1; base < tokens.size(); base += piece, piece = piece * 2 + 1) {
+    const std::size_t count = std::min(piece, tokens.size() - base);
+    encoded +=
+        parseDecimalDictionary(tokens.data() + base, count, dictionary, codes.data() + base, errors.data() + base);
+  }
+
+  std::vector<T> seen;
+  std::size_t expectedEncoded = 0;
+  for (std::size_t i = 0; i < tokens.size(); ++i) {
+    u64 value = 0;
+    ParseError expected = parseDecimal(tokens[i].data(), tokens[i].size(), value);
+    if (expected == ParseError::None && value > static_cast<u64>(std::numeric_limits<T>::max())) {
+      expected = ParseError::Overflow;
+    }
+    std::size_t code = 0;
+    if (expected == ParseError::None) {
+      code = static_cast<std::size_t>(std::find(seen.begin(), seen.end(), static_cast<T>(value)) - seen.begin());
+      if (code == seen.size() && seen.size() == std::size_t{std::numeric_limits<Code>::max()} + 1) {
+        expected = ParseError::Overflow;  // Out of codes
+        code = 0;
+      } else if (code == seen.size()) {
+        seen.push_back(static_cast<T>(value));
+      }
+    }
+    expectedEncoded += expected == ParseError::None ? 1 : 0;
+    CHECK(errors[i] == expected && codes[i] == code);
+  }
+  CHECK(encoded == expectedEncoded && dictionary.values == seen);
+  for (std::size_t code = 0; code < seen.size(); ++code) {
+    Code found = 0;
+    CHECK(dictionary.lookup(seen[code], found) && found == code);
+  }
+}
+
+void testDictionary() {
+  gContext = "dictionary";
+  std::mt19937_64 rng(97);
+  std::vector<std::string> tokens = batchTokens(rng);
+  std::vector<u64> pool;
+  for (int i = 0; i < 300; ++i) {
+    pool.push_back(i < 100 ? static_cast<u64>(i) : rng() >> (rng() % 64));
+  }
+  for (int i = 0; i < 5000; ++i) {
+    // Skewed toward the front of the pool, as status codes are
+    tokens.push_back(decimalText(pool[std::min(rng() % pool.size(), rng() % pool.size())]));
+  }
+
+  testDictionaryType<std::uint64_t, std::uint8_t>(tokens);
+  testDictionaryType<std::uint64_t, std::uint16_t>(tokens);
+  testDictionaryType<std::uint16_t, std::uint8_t>(tokens);
+  testDictionaryType<std::int32_t, std::uint16_t>(tokens);
+
+  // Every code a uint16_t has, through several rehashes, and then none left
+  DecimalDictionary<std::uint32_t, std::uint16_t> dictionary;
+  bool ok = true;
+  for (std::uint32_t value = 0; value < 65536; ++value) {
+    std::uint16_t code = 0;
+    ok = ok && dictionary.encode(value * 7919, code) == ParseError::None && code == value;
+  }
+  std::uint16_t code = 0;
+  CHECK(ok && dictionary.values.size() == 65536);
+  CHECK(dictionary.encode(1, code) == ParseError::Overflow && !dictionary.lookup(1, code));
+  CHECK(dictionary.encode(7919 * 1000, code) == ParseError::None && code == 1000);
+
+  // Codes a byte wide until the 257th distinct value, then all of them two
+  for (std::size_t distinct : {std::size_t{200}, std::size_t{256}, std::size_t{257}, std::size_t{1000}}) {
+    std::vector<std::string> column;
+    for (std::size_t i = 0; i < 3000; ++i) {
+      column.push_back(decimalText((i < distinct ? i : rng() % distinct) * 7 + 1));
+    }
+    column.push_back("x");
+    DecimalDictionary<std::uint32_t, std::uint16_t> adaptive;
+    DictionaryCodes adaptiveCodes;
+    std::vector<ParseError> adaptiveErrors(column.size());
+    // In two pieces, the width carrying over
+    std::size_t encoded = parseDecimalDictionary(column.data(), 100, adaptive, adaptiveCodes, adaptiveErrors.data());
+    encoded += parseDecimalDictionary(column.data() + 100, column.size() - 100, adaptive, adaptiveCodes,
+                                      adaptiveErrors.data() + 100);
+    CHECK(encoded == column.size() - 1 && adaptive.values.size() == distinct);
+    CHECK(adaptiveCodes.width == (distinct <= 256 ? 1u : 2u) && adaptiveCodes.size() == column.size());
+    CHECK(adaptiveCodes.narrow.empty() != adaptiveCodes.wide.empty());
+    CHECK(adaptiveErrors.back() == ParseError::InvalidDigit);
+    bool same = true;
+    for (std::size_t i = 0; i + 1 < column.size(); ++i) {
+      same = same && decimalText(adaptive.values[adaptiveCodes[i]]) == column[i];
+    }
+    CHECK(same && adaptiveCodes[column.size() - 1] == 0);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Range lists against setting each bit of each range one at a time.
+void testRangeLists() {
+  gContext = "range-list";
+  std::mt19937_64 rng(98);
+  for (int trial = 0; trial < 2000; ++trial) {
+    const std::size_t bitCount = 1 + rng() % 300;
+    std::vector<bool> expected(bitCount);
+    std::string text;
+    for (std::size_t items = rng() % 6; items > 0; --items) {
+      const u64 first = rng() % bitCount;
+      const u64 last = rng() % 2 == 0 ? first : first + rng() % (bitCount - first);
+      text += (text.empty() ? "" : ",") + decimalText(first);
+      text += last != first || rng() % 8 == 0 ? "-" + decimalText(last) : "";
+      for (u64 bit = first; bit <= last; ++bit) {
+        expected[bit] = true;
+      }
+    }
+    text += rng() % 2 == 0 ? "\n" : "";
+    u64 words[5];
+    std::memset(words, 0xa5, sizeof(words));
+    bool matched = parseRangeList(text.data(), text.size(), words, bitCount) == ParseError::None;
+    for (std::size_t bit = 0; bit < bitCount; ++bit) {
+      matched = matched && ((words[bit / 64] >> (bit % 64) & 1) != 0) == expected[bit];
+    }
+    CHECK(matched && (bitCount % 64 == 0 || words[bitCount / 64] >> (bitCount % 64) == 0));
+  }
+
+  u64 words[2];
+  CHECK(parseRangeList("", 0, words, 128) == ParseError::None && words[0] == 0 && words[1] == 0);
+  CHECK(parseRangeList("\n", 1, words, 128) == ParseError::None && words[0] == 0);
+  CHECK(parseRangeList("0-63,64", 7, words, 128) == ParseError::None && words[0] == ~u64{0} && words[1] == 1);
+  CHECK(parseRangeList("5,127", 5, words, 128) == ParseError::None && words[0] == 32 && words[1] == u64{1} << 63);
+  CHECK(parseRangeList("1,128", 5, words, 128) == ParseError::Overflow && words[0] == 2);
+  CHECK(parseRangeList("1-99999999999999999999", 22, words, 128) == ParseError::Overflow);
+  CHECK(parseRangeList("0-3,", 4, words, 128) == ParseError::Empty && words[0] == 15);
+  CHECK(parseRangeList(",1", 2, words, 128) == ParseError::Empty);
+  CHECK(parseRangeList("1-", 2, words, 128) == ParseError::Empty);
+  CHECK(parseRangeList("-1", 2, words, 128) == ParseError::Empty);
+  CHECK(parseRangeList("5-3", 3, words, 128) == ParseError::InvalidDigit);
+  CHECK(parseRangeList("1-2-3", 5, words, 128) == ParseError::InvalidDigit);
+  CHECK(parseRangeList("1 ,2", 4, words, 128) == ParseError::InvalidDigit);
+  CHECK(parseRangeList("0-3\n\n", 5, words, 128) == ParseError::InvalidDigit);
+
+  std::bitset<100> bits;
+  CHECK(parseRangeList("0,63-64,99", 10, bits) == ParseError::None && bits.count() == 4 && bits[0] && bits[63] &&
+        bits[64] && bits[99]);
+  CHECK(parseRangeList("100", 3, bits) == ParseError::Overflow && bits.none());
+  std::bitset<10> small;
+  CHECK(parseRangeList("2-9", 3, small) == ParseError::None && small.to_ulong() == 0x3fc);
+  CpuSet cpus;
+  CHECK(parseCpuList("0-3,8\n", 6, cpus) == ParseError::None && cpus.words[0] == 0x10f && cpus.contains(8));
+  CHECK(parseCpuList("1024", 4, cpus) == ParseError::Overflow);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Identifier codecs against a plain strtoull for base-36, and by hand for Crockford.
+void testIdentifiers() {
+  gContext = "identifiers";
+  for (u64 expected : interestingValues()) {
+    char buffer[kMaxBase36Chars] = {};
+    u64 value = 0;
+    std::size_t length = formatBase36(expected, buffer);
+    CHECK(std::strtoull(std::string(buffer, length).c_str(), nullptr, 36) == expected);
+    CHECK(parseBase36(buffer, length, value) == ParseError::None && value == expected);
+
+    length = formatBase32(expected, buffer);
+    u64 manual = 0;
+    for (std::size_t i = 0; i < length; ++i) {
+      manual = manual * 32 + static_cast<u64>(std::strchr("0123456789ABCDEFGHJKMNPQRSTVWXYZ", buffer[i]) -
+                                              "0123456789ABCDEFGHJKMNPQRSTVWXYZ");
+    }
+    CHECK(manual == expected);
+    CHECK(parseBase32(buffer, length, value) == ParseError::None && value == expected);
+  }
+
+  u64 value = 0;
+  CHECK(parseBase36("ZZ9abc", 6, value) == ParseError::None && value == 2175535992u);
+  CHECK(parseBase36("3w5e11264sgsf", 13, value) == ParseError::None && value == ~u64{0});
+  CHECK(parseBase36("3w5e11264sgsg", 13, value) == ParseError::Overflow);
+  CHECK(parseBase36("00003w5e11264sgsf", 17, value) == ParseError::None && value == ~u64{0});
+  CHECK(parseBase36("zz-9", 4, value) == ParseError::InvalidDigit);
+  CHECK(parseBase36("", 0, value) == ParseError::Empty);
+  CHECK(parseBase32("FZZZZZZZZZZZZ", 13, value) == ParseError::None && value == ~u64{0});
+  CHECK(parseBase32("G000000000000", 13, value) == ParseError::Overflow);
+  CHECK(parseBase32("oOoFZZZZZZZZZZZZ", 16, value) == ParseError::None && value == ~u64{0});
+  CHECK(parseBase32("iLo", 3, value) == ParseError::None && value == 32 * 32 + 32);
+  CHECK(parseBase32("u", 1, value) == ParseError::InvalidDigit);
+  CHECK(parseBase32("\x80", 1, value) == ParseError::InvalidDigit);
+}
+
+#if SCW_INTLIT_HAS_PMR
+////////////////////////////////////////////////////////////////////////////////
+/// Columns into caller memory: the same answers as parseDecimalBatch, and through a
+/// context, nothing asked of upstream once a round of the same shape has been seen.
+struct CountingResource : std::pmr::memory_resource {
+  std::size_t allocations = 0;
+  std::size_t live = 0;
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++allocations;
+    ++live;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+    --live;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+template <typename T>
+bool sameAsBatch(const DecimalColumn<T>& column, const std::vector<std::string>& tokens) {
+  std::vector<T> values(tokens.size());
+  std::vector<ParseError> errors(tokens.size());
+  const std::size_t parsed = parseDecimalBatch(tokens.data(), tokens.size(), values.data(), errors.data());
+  return column.parsed == parsed && column.values.size() == values.size() &&
+         std::equal(values.begin(), values.end(), column.values.begin()) &&
+         std::equal(errors.begin(), errors.end(), column.errors.begin());
+}
+
+void testColumns() {
+  gContext = "columns";
+  std::mt19937_64 rng(100);
+  std::vector<std::string> tokens;
+  std::string text;
+  for (const std::string& token : batchTokens(rng)) {
+    if (token.find(',') == std::string::npos) {
+      tokens.push_back(token);
+      text += token + ",";
+    }
+  }
+
+  const Isa tiers[] = {Isa::Scalar, Isa::Swar, Isa::Sse41, Isa::Avx2, Isa::Avx512};
+  for (Isa isa : tiers) {
+    const KernelTable table = resolveKernels(isa);
+    CountingResource upstream;
+    {
+      ParseContext context(table, &upstream);
+      for (int round = 0; round < 4; ++round) {
+        const std::size_t before = upstream.allocations;
+        {
+          const DecimalColumn<std::uint32_t> narrow = parseDecimalColumn<std::uint32_t>(context, tokens.data(),
+                                                                                        tokens.size());
+          const DecimalColumn<u64> wide = parseDecimalColumn<u64>(context, text.data(), text.size(), ',');
+          CHECK(sameAsBatch(narrow, tokens) && sameAsBatch(wide, tokens));
+        }
+        CHECK(round < 1 || upstream.allocations == before);
+        context.reset();
+        CHECK(context.arena().used() == 0 && upstream.live == (context.arena().capacity() != 0 ? 1u : 0u));
+      }
+    }
+    CHECK(upstream.live == 0);
+  }
+
+  // A bigger round spills again, once
+  CountingResource upstream;
+  ParseArena arena(&upstream);
+  const std::size_t rounds[][2] = {{100, 1}, {100, 0}, {5000, 1}, {5000, 0}, {64, 0}};  // Bytes, and if it spills
+  for (const std::size_t (&round)[2] : rounds) {
+    const std::size_t before = upstream.allocations;
+    {
+      std::pmr::vector<char> bytes(round[0], 'x', &arena);
+      std::pmr::vector<u64> words(3, 0, &arena);
+      CHECK(reinterpret_cast<std::uintptr_t>(words.data()) % alignof(u64) == 0);
+    }
+    CHECK((upstream.allocations != before) == (round[1] != 0));
+    arena.reset();
+  }
+  CHECK(arena.capacity() >= 5000 && upstream.live == 1);
+
+  // Any resource works, and delimited text keeps its empty tokens but not a last delimiter
+  std::pmr::monotonic_buffer_resource monotonic;
+  const DecimalColumn<std::uint8_t> bytes = parseDecimalColumn<std::uint8_t>(tokens.data(), tokens.size(), &monotonic);
+  CHECK(sameAsBatch(bytes, tokens) && bytes.values.get_allocator().resource() == &monotonic);
+  const DecimalColumn<u64> edges = parseDecimalColumn<u64>("7,,256\n", 7, ',');
+  CHECK(edges.values.size() == 3 && edges.parsed == 1 && edges.values[0] == 7);
+  CHECK(edges.errors[1] == ParseError::Empty && edges.errors[2] == ParseError::InvalidDigit);
+  CHECK(parseDecimalColumn<u64>("", 0, ',').values.empty() && parseDecimalColumn<u64>("9,", 2, ',').values.size() == 1);
+
+  // Each thread its own context
+  ParseContext* mine = &ParseContext::local();
+  ParseContext* theirs = nullptr;
+  std::thread([&theirs] { theirs = &ParseContext::local(); }).join();
+  CHECK(mine == &ParseContext::local() && theirs != nullptr && theirs != mine);
+  CHECK(&mine->kernels() == &activeKernels());
+}
+#endif  // SCW_INTLIT_HAS_PMR
+
+#if defined(__SIZEOF_INT128__)
+
+////////////////////////////////////////////////////////////////////////////////
+/// 128-bit text against a digit at a time loop of 128-bit divisions, and back again.
+std::string text128(u128 value, unsigned radix) {
+  std::string text;
+  do {
+    text.insert(text.begin(), "0123456789abcdef"[static_cast<unsigned>(value % radix)]);
+    value /= radix;
+  } while (value != 0);
+  return text;
+}
+
+void testInt128() {
+  gContext = "int128";
+  std::mt19937_64 rng(93);
+  std::vector<u128> values = {0, 1, 9, 10, ~u128{0}, ~u128{0} - 1, u128{1} << 127, (u128{1} << 127) - 1};
+  u128 power = 1;
+  for (int i = 0; i <= 38; ++i) {
+    values.push_back(power - 1);
+    values.push_back(power);
+    values.push_back(power + 1);
+    values.push_back(power * 9);
+    power *= 10;
+  }
+  for (int shift = 0; shift < 128; ++shift) {
+    values.push_back(u128{1} << shift);
+    values.push_back(~u128{0} >> shift);
+  }
+  for (int trial = 0; trial < 5000; ++trial) {
+    const u128 value = static_cast<u128>(rng()) << 64 | rng();
+    values.push_back(value >> (rng() % 128));
+  }
+
+  for (u128 expected : values) {
+    char buffer[kMaxBinary128Chars];
+    u128 value = 0;
+    std::size_t length = formatDecimal128(expected, buffer);
+    CHECK(std::string(buffer, length) == text128(expected, 10));
+    CHECK(parseDecimal128(buffer, length, value) == ParseError::None && value == expected);
+    length = formatHex128(expected, buffer);
+    CHECK(std::string(buffer, length) == text128(expected, 16));
+    CHECK(parseHex128(buffer, length, value) == ParseError::None && value == expected);
+    length = formatBinary128(expected, buffer);
+    CHECK(std::string(buffer, length) == text128(expected, 2));
+    CHECK(parseBinary128(buffer, length, value) == ParseError::None && value == expected);
+
+    const i128 negative = static_cast<i128>(0 - (expected >> 1));
+    length = formatDecimal128(negative, buffer);
+    CHECK(std::string(buffer, length) == (negative < 0 ? "-" : "") + text128(expected >> 1, 10));
+  }
+
+  char buffer[kMaxDecimal128Chars];
+  const i128 minimum = static_cast<i128>(u128{1} << 127);
+  CHECK(std::string(buffer, formatDecimal128(minimum, buffer)) == "-170141183460469231731687303715884105728");
+  CHECK(std::string(buffer, formatDecimal128(i128{-1}, buffer)) == "-1");
+  CHECK(std::string(buffer, formatDecimal128(i128{0}, buffer)) == "0");
+
+  u128 value = 0;
+  const std::string max = "340282366920938463463374607431768211455";
+  CHECK(parseDecimal128(max.data(), max.size(), value) == ParseError::None && value == ~u128{0});
+  CHECK(parseDecimal128("340282366920938463463374607431768211456", 39, value) == ParseError::Overflow);
+  CHECK(parseDecimal128("999999999999999999999999999999999999999", 39, value) == ParseError::Overflow);
+  CHECK(parseDecimal128("1000000000000000000000000000000000000000", 40, value) == ParseError::Overflow);
+  CHECK(value == ~u128{0});  // Untouched by the failed parses
+  CHECK(parseDecimal128("9999999999999999999999999999999999999999x", 41, value) == ParseError::InvalidDigit);
+  const std::string padded = std::string(50, '0') + max;
+  CHECK(parseDecimal128(padded.data(), padded.size(), value) == ParseError::None && value == ~u128{0});
+  CHECK(parseDecimal128("", 0, value) == ParseError::Empty);
+  CHECK(parseHex128("1ffffffffffffffffffffffffffffffff", 33, value) == ParseError::Overflow && value == ~u128{0});
+  CHECK(parseHex128("0ffffffffffffffffffffffffffffffff", 33, value) == ParseError::None && value == ~u128{0});
+  CHECK(parseHex128("1x0000000000000000", 18, value) == ParseError::InvalidDigit);
+  CHECK(parseHex128("10000000000000000000000000000000000000g", 39, value) == ParseError::InvalidDigit);
+  CHECK(parseHex128("", 0, value) == ParseError::Empty);
+  const std::string bits = "1" + std::string(128, '0');
+  CHECK(parseBinary128(bits.data(), bits.size(), value) == ParseError::Overflow && value == ~u128{0});
+  CHECK(parseBinary128(bits.data() + 1, bits.size() - 1, value) == ParseError::None && value == 0);
+  CHECK(parseBinary128("12", 2, value) == ParseError::InvalidDigit);
+}
+
+#endif  // __SIZEOF_INT128__
+
+////////////////////////////////////////////////////////////////////////////////
+/// hash64 loads words where the literal side assembles them from characters, so check
+/// they agree on every length through several long-key steps, with any byte values.
+void testHash() {
+  gContext = "hash";
+  std::mt19937_64 rng(85);
+  std::string key;
+  for (std::size_t length = 0; length <= 80; ++length) {
+    for (int trial = 0; trial < 20; ++trial) {
+      key.resize(length);
+      for (char& ch : key) {
+        ch = static_cast<char>(rng());
+      }
+      const std::string padded = "xyz" + key;
+      const u64 expected = SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::intliterals::detail::hashText(key.data(), length);
+      CHECK(hash64(key.data(), length) == expected);
+      CHECK(hash64(padded.data() + 3, length) == expected);
+    }
+  }
+  CHECK(hash64("host", 4) != hash64("hosT", 4));
+  CHECK(hash64("abcdefghijklmnopq", 17) != hash64("abcdefghijklmnopr", 17));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The same work from several threads has to add up exactly once the threads are done,
+/// and count nothing at all when statistics are compiled out.
+void testStats() {
+  gContext = kStatsEnabled ? "stats" : "no-stats";
+  const int kThreads = 4;
+  const u64 kValues = 1000;
+  const StatsSnapshot before = statsSnapshot();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([] {
+      char buffer[kMaxDecimalChars];
+      u64 value = 0;
+      for (u64 i = 0; i < kValues; ++i) {
+        parseDecimal(buffer, formatDecimal(i * 7919, buffer), value);
+      }
+      parseDecimal("12x4", 4, value);
+      parseHex("", 0, value);
+      parseBinary(std::string(65, '1').c_str(), 65, value);
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  const StatsSnapshot delta = statsSnapshot().since(before);
+  const u64 scale = kStatsEnabled ? 1 : 0;
+  u64 formattedBytes = 0;
+  for (u64 i = 0; i < kValues; ++i) {
+    formattedBytes += decimalText(i * 7919).size();
+  }
+  CHECK(delta.valuesParsed == scale * kThreads * kValues);
+  CHECK(delta.valuesFormatted == scale * kThreads * kValues);
+  CHECK(delta.bytesFormatted == scale * kThreads * formattedBytes);
+  CHECK(delta.bytesConsumed == scale * kThreads * (formattedBytes + 4 + 65));
+  CHECK(delta.errors[static_cast<std::size_t>(ParseError::InvalidDigit)] == scale * kThreads);
+  CHECK(delta.errors[static_cast<std::size_t>(ParseError::Empty)] == scale * kThreads);
+  CHECK(delta.errors[static_cast<std::size_t>(ParseError::Overflow)] == scale * kThreads);
+
+  u64 kernelCalls = 0;
+  for (u64 calls : delta.kernelCalls) {
+    kernelCalls += calls;
+  }
+  CHECK(kernelCalls == scale * kThreads * (2 * kValues + 3));
+  CHECK(delta.kernelCalls[static_cast<std::size_t>(activeKernelIsa(KernelOp::FormatDecimal))] >=
+        scale * kThreads * kValues);
+  // Blocks of exited threads are reused, so the workers add at most one each
+  const StatsSnapshot after = statsSnapshot();
+  CHECK(after.threads >= scale && delta.threads <= scale * kThreads && after.since(after).threads == 0);
+
+  // Ten distinct values in a hundred tokens: the other ninety are dictionary hits
+  std::vector<std::string> codes;
+  for (int i = 0; i < 100; ++i) {
+    codes.push_back(decimalText(static_cast<u64>(i % 10) * 1000));
+  }
+  const StatsSnapshot beforeHits = statsSnapshot();
+  DecimalDictionary<std::uint16_t, std::uint8_t> dictionary;
+  std::vector<std::uint8_t> codeValues(codes.size());
+  std::vector<ParseError> codeErrors(codes.size());
+  parseDecimalDictionary(codes.data(), codes.size(), dictionary, codeValues.data(), codeErrors.data());
+  u64 expectedHits = 90;
+#if SCW_INTLIT_HAS_PMR
+  ParseContext context;
+  parseDecimalColumn<std::uint16_t>(context, codes.data(), codes.size());
+  expectedHits += 1;
+#endif
+
+  CHECK(statsSnapshot().since(beforeHits).cacheHits == scale * expectedHits);
+}
+
+}  // namespace
+
+int main() {
+  // Every tier this machine can run, then whatever dispatch picked
+  const Isa tiers[] = {Isa::Scalar, Isa::Swar, Isa::Sse41, Isa::Avx2, Isa::Avx512};
+  for (Isa isa : tiers) {
+    const KernelTable table = resolveKernels(isa);
+    CHECK(table.limit <= isa);
+    for (std::size_t op = 0; op < kKernelOpCount; ++op) {
+      CHECK(table.isa[op] <= table.limit);
+    }
+    testTable(table);
+    testAddresses(table);
+    testUuids(table);
+    testBatch(table);
+  }
+
+  {
+    const KernelTable& table = activeKernels();
+    testTable(table);
+    testBatch(table);
+    gContext = "dispatch";
+
+    // SCW_INTLIT_ISA can only lower the tier
+    Isa requested = Isa::Avx512;
+    const bool overridden = isaFromName(std::getenv("SCW_INTLIT_ISA"), requested);
+    CHECK(table.limit == (requested < table.detected ? requested : table.detected));
+    CHECK(!overridden || activeKernelIsa(KernelOp::ParseDecimal) <= requested);
+
+    std::printf("Detected %s, running %s:", isaName(table.detected), isaName(table.limit));
+    for (std::size_t op = 0; op < kKernelOpCount; ++op) {
+      std::printf(" %s=%s", kernelOpName(static_cast<KernelOp>(op)), isaName(table.isa[op]));
+    }
+    std::printf("\n");
+
+    u64 value = 0;
+    CHECK(parseRadix("0777", 4, 8, value) == ParseError::None && value == 0777);
+    CHECK(parseRadix("ff", 2, 16, value) == ParseError::None && value == 0xff);
+
+    // Octal is the one radix whose full length values can go either way on the first digit
+    CHECK(parseRadix("1777777777777777777777", 22, 8, value) == ParseError::None && value == ~u64{0});
+    CHECK(parseRadix("0001777777777777777777777", 25, 8, value) == ParseError::None && value == ~u64{0});
+    CHECK(parseRadix("2000000000000000000000", 22, 8, value) == ParseError::Overflow);
+    CHECK(parseRadix("17777777777777777777770", 23, 8, value) == ParseError::Overflow);
+  }
+
+  testIdentifiers();
+  testReduce();
+  testSelect();
+  testDictionary();
+  testRangeLists();
+#if SCW_INTLIT_HAS_PMR
+  testColumns();
+#endif
+#if defined(__SIZEOF_INT128__)
+  testInt128();
+#endif
+  testHash();
+  testStats();
+
+  return gFailures == 0 ? 0 : 1;
+}
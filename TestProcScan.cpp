@@ -0,0 +1,224 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE
+#define SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE scw
+#endif
+
+#include "FixedWidthProcScan.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+using namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::procscan;
+
+namespace {
+
+int gFailures = 0;
+const char* gContext = "";
+
+void check(bool ok, const char* what, int line) {
+  if (!ok) {
+    std::fprintf(stderr, "TestProcScan.cpp:%d: [%s] check failed: %s\n", line, gContext, what);
+    ++gFailures;
+  }
+}
+
+#define CHECK(cond_) check((cond_), #cond_, __LINE__)
+
+/// A fixture through ProcFile, the way an agent polls, into a string for the checks.
+std::string readFixture(const char* name) {
+  const std::string path = std::string(SCW_PROCSCAN_FIXTURES) + "/" + name;
+  const ProcFile file(path.c_str());
+  char buffer[16384];
+  const long length = file.isOpen() ? file.read(buffer, sizeof(buffer)) : -1;
+  CHECK(length > 0 && length < static_cast<long>(sizeof(buffer)));
+  return length > 0 ? std::string(buffer, static_cast<std::size_t>(length)) : std::string();
+}
+
+void testFields() {
+  gContext = "fields";
+  u64 fields[3] = {7, 7, 7};
+  ScanResult result = scanFields("400000 100000\n", 14, fields, 3);
+  CHECK(result.error == ParseError::None && result.fields == 2 && fields[0] == 400000 && fields[1] == 100000);
+  CHECK(fields[2] == 7);
+  result = scanFields("max 100000\n", 11, fields, 3);
+  CHECK(result.error == ParseError::None && result.fields == 2 && fields[0] == UINT64_MAX && fields[1] == 100000);
+  std::uint32_t limits[2] = {};
+  CHECK(scanFields("max max", 7, limits, 2).fields == 2 && limits[0] == UINT32_MAX && limits[1] == UINT32_MAX);
+  CHECK(scanFields("maximum 1", 9, limits, 2).error == ParseError::InvalidDigit);
+  std::int32_t small[2] = {};
+  result = scanFields("-2147483648 2147483648", 22, small, 2);
+  CHECK(result.error == ParseError::Overflow && result.fields == 1 && small[0] == INT32_MIN);
+  std::uint8_t tiny[2] = {};
+  CHECK(scanFields("\t255  0 ", 8, tiny, 2).fields == 2 && tiny[0] == 255);
+  CHECK(scanFields("", 0, tiny, 2).fields == 0);
+
+  const std::string cpuMax = readFixture("sys/fs/cgroup/cpu.max");
+  CHECK(scanFields(cpuMax.data(), cpuMax.size(), fields, 3).fields == 2 && fields[0] == 400000 && fields[1] == 100000);
+  const std::string current = readFixture("sys/fs/cgroup/memory.current");
+  CHECK(scanFields(current.data(), current.size(), fields, 1).fields == 1 && fields[0] == 3358687232u);
+}
+
+void testKeyed() {
+  gContext = "keyed";
+  const std::string meminfo = readFixture("proc/meminfo");
+  MemInfo memory = {};
+  const ScanResult result = scanKeyed(meminfo.data(), meminfo.size(), kMemInfoFields, memory);
+  CHECK(result.error == ParseError::None && result.fields == sizeof(kMemInfoFields) / sizeof(kMemInfoFields[0]));
+
+  // Against sscanf over the same lines
+  for (const KeyedField<MemInfo>& field : kMemInfoFields) {
+    const std::string key = std::string("\n") + field.key + ":";
+    const std::size_t at = ("\n" + meminfo).find(key);
+    std::uint64_t expected = 0;
+    CHECK(at != std::string::npos &&
+          std::sscanf(meminfo.c_str() + at + key.size() - 1, "%" SCNu64, &expected) == 1);
+    CHECK(memory.*field.member == expected);
+  }
+  CHECK(memory.total >= memory.free && memory.total > 0);
+
+  const std::string cpu = readFixture("sys/fs/cgroup/cpu.stat");
+  CgroupCpuStat cgroup = {};
+  CHECK(scanKeyed(cpu.data(), cpu.size(), kCgroupCpuStatFields, cgroup).fields == 6);
+  CHECK(cgroup.usageUsec == 84813523914u && cgroup.throttled == 10424 && cgroup.throttledUsec == 310218552);
+
+  // Keys out of file order still all match, and a bad value stops the scan
+  const KeyedField<CgroupCpuStat> reversed[] = {{"throttled_usec", &CgroupCpuStat::throttledUsec},
+                                                {"usage_usec", &CgroupCpuStat::usageUsec}};
+  CgroupCpuStat partial = {};
+  CHECK(scanKeyed(cpu.data(), cpu.size(), reversed, partial).fields == 2 && partial.usageUsec == cgroup.usageUsec);
+  const char bad[] = "usage_usec 12\nuser_usec 1x\nsystem_usec 5\n";
+  const ScanResult failed = scanKeyed(bad, sizeof(bad) - 1, kCgroupCpuStatFields, partial);
+  CHECK(failed.error == ParseError::InvalidDigit && failed.fields == 1 && partial.usageUsec == 12);
+  const char missing[] = "usage_usec\nnr_periods: 3";
+  CHECK(scanKeyed(missing, sizeof(missing) - 1, kCgroupCpuStatFields, partial).error == ParseError::Empty);
+
+  // A last line with no newline ends the scan at the end of the text
+  const char unterminated[] = {'n', 'r', '_', 'p', 'e', 'r', 'i', 'o', 'd', 's', ' ', '4', '2'};
+  CHECK(scanKeyed(unterminated, sizeof(unterminated), kCgroupCpuStatFields, partial).fields == 1);
+  CHECK(partial.periods == 42);
+}
+
+void testProcStat() {
+  gContext = "proc-stat";
+  const std::string text = readFixture("proc/stat");
+  ProcStat stat = {};
+  CpuTimes cpus[32] = {};
+  const ScanResult result = scanProcStat(text.data(), text.size(), stat, cpus, 32);
+  CHECK(result.error == ParseError::None && result.fields == 17 * 10 + 5 && stat.cpuCount == 16);
+  CHECK(stat.contextSwitches == 1843299117u && stat.bootTime == 1792326060u && stat.processes == 4810923);
+  CHECK(stat.running == 3 && stat.blocked == 0);
+
+  // Nothing past an unterminated cpu line is taken for the counters
+  const char cpuOnly[] = {'c', 'p', 'u', ' ', ' ', '1', ' ', '2', ' ', '3', ' ', '4'};
+  ProcStat partialStat = {};
+  const ScanResult cpuResult = scanProcStat(cpuOnly, sizeof(cpuOnly), partialStat, cpus, 32);
+  CHECK(cpuResult.error == ParseError::None && cpuResult.fields == 4 && partialStat.total.idle == 4);
+
+  // The total line is the sum of the others, and both match sscanf
+  u64 user = 0;
+  u64 idle = 0;
+  for (std::size_t cpu = 0; cpu < stat.cpuCount; ++cpu) {
+    user += cpus[cpu].user;
+    idle += cpus[cpu].idle;
+  }
+  CHECK(user == stat.total.user && idle == stat.total.idle);
+  const std::size_t line = text.find("\ncpu7 ");
+  unsigned long long expected[10] = {};
+  CHECK(std::sscanf(text.c_str() + line, " cpu7 %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu", &expected[0],
+                    &expected[1], &expected[2], &expected[3], &expected[4], &expected[5], &expected[6], &expected[7],
+                    &expected[8], &expected[9]) == 10);
+  CHECK(cpus[7].user == expected[0] && cpus[7].system == expected[2] && cpus[7].softirq == expected[6] &&
+        cpus[7].guestNice == expected[9]);
+
+  // CPUs past the array are counted but not stored, and short lines leave the rest alone
+  ProcStat few = {};
+  CpuTimes one[1] = {};
+  one[0].steal = 99;
+  const char older[] = "cpu  1 2 3 4\ncpu0 1 2 3 4\ncpu3 5 6 7 8\nctxt 10\n";
+  const ScanResult partial = scanProcStat(older, sizeof(older) - 1, few, one, 1);
+  CHECK(partial.error == ParseError::None && partial.fields == 9 && few.cpuCount == 4 && one[0].idle == 4);
+  CHECK(one[0].steal == 99 && few.contextSwitches == 10);
+  const char bad[] = "cpu  1 2 x 4\n";
+  CHECK(scanProcStat(bad, sizeof(bad) - 1, few, one, 1).error == ParseError::InvalidDigit);
+}
+
+void testPidStat() {
+  gContext = "pid-stat";
+  const char* const kPids[] = {"1", "10", "14", "15", "166", "168", "4242", "4243"};
+  for (const char* pid : kPids) {
+    const std::string text = readFixture(("proc/" + std::string(pid) + "/stat").c_str());
+    PidStat stat = {};
+    const ScanResult result = scanPidStat(text.data(), text.size(), stat);
+    CHECK(result.error == ParseError::None && result.fields == 24 && stat.pid == std::atoi(pid));
+
+    // sscanf agrees past the command, found the same way
+    const char* after = text.c_str() + text.rfind(')') + 2;
+    char state = 0;
+    int parent = 0;
+    long long nice = 0;
+    unsigned long long userTime = 0;
+    unsigned long long virtualBytes = 0;
+    long long resident = 0;
+    CHECK(std::sscanf(after,
+                      "%c %d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu "
+                      "%*u %*d %*d %*d %lld %*d %*d %*u %llu %lld",
+                      &state, &parent, &userTime, &nice, &virtualBytes, &resident) == 6);
+    CHECK(stat.state == state && stat.parent == parent && stat.userTime == userTime && stat.nice == nice);
+    CHECK(stat.virtualBytes == virtualBytes && stat.residentPages == resident);
+  }
+
+  PidStat stat = {};
+  const std::string odd = readFixture("proc/4243/stat");
+  CHECK(scanPidStat(odd.data(), odd.size(), stat).error == ParseError::None &&
+        std::strcmp(stat.command, "odd) name") == 0);
+  const std::string kernel = readFixture("proc/10/stat");
+  CHECK(scanPidStat(kernel.data(), kernel.size(), stat).error == ParseError::None && stat.nice == -20 &&
+        std::strcmp(stat.command, "kworker/0:0H-ev") == 0 && stat.tty == 0 && stat.terminalGroup == -1);
+  CHECK(scanPidStat("", 0, stat).error == ParseError::Empty);
+  CHECK(scanPidStat("12 (x", 5, stat).error == ParseError::InvalidDigit);
+  CHECK(scanPidStat("12 (x) S 1", 10, stat).error == ParseError::Empty);
+  CHECK(scanPidStat("12 (x) SS 1", 11, stat).error == ParseError::InvalidDigit);
+  ScanResult result = scanPidStat("x (y) S 1", 9, stat);
+  CHECK(result.error == ParseError::InvalidDigit && result.fields == 0 && std::strcmp(stat.command, "y") != 0);
+  result = scanPidStat("12 (y) SS 1", 11, stat);
+  CHECK(result.fields == 2 && std::strcmp(stat.command, "y") == 0);
+
+  // The live file, where there is one
+  const ProcFile self("/proc/self/stat");
+  char buffer[1024];
+  const long length = self.isOpen() ? self.read(buffer, sizeof(buffer)) : -1;
+  if (length > 0) {
+    CHECK(scanPidStat(buffer, static_cast<std::size_t>(length), stat).error == ParseError::None);
+    CHECK(stat.pid == static_cast<std::int32_t>(::getpid()) && stat.threads >= 1);
+  }
+}
+
+}  // namespace
+
+int main() {
+  testFields();
+  testKeyed();
+  testProcStat();
+  testPidStat();
+  return gFailures == 0 ? 0 : 1;
+}
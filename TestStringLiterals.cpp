@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE
+#define SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE scw
+#endif
+
+#include "FixedWidthStringLiterals.h"
+#include "FixedWidthIntParse.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+using namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::intliterals;
+namespace intparse = SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::intparse;
+
+namespace {
+
+int gFailures = 0;
+
+void check(bool ok, const char* what, int line) {
+  if (!ok) {
+    std::fprintf(stderr, "TestStringLiterals.cpp:%d: check failed: %s\n", line, what);
+    ++gFailures;
+  }
+}
+
+#define CHECK(cond_) check((cond_), #cond_, __LINE__)
+
+////////////////////////////////////////////////////////////////////////////////
+/// The dispatch _h64 is for: hash once, switch, then confirm the one candidate.
+int headerIndex(const std::string& name) {
+  switch (intparse::hash64(name.data(), name.size())) {
+    case "content-length"_h64: return name == "content-length" ? 1 : 0;
+    case "content-type"_h64: return name == "content-type" ? 2 : 0;
+    case "host"_h64: return name == "host" ? 3 : 0;
+    case ""_h64: return name.empty() ? 4 : 0;
+    case "x-a-header-name-longer-than-sixteen"_h64: return name == "x-a-header-name-longer-than-sixteen" ? 5 : 0;
+    default: return 0;
+  }
+}
+
+}  // namespace
+
+int main() {
+
+  // These should cause a compile error if you uncomment them
+  {
+//    constexpr auto b36a = ""_b36u64;
+//    constexpr auto b36b = "zz-9"_b36u64;
+//    constexpr auto b36c = "3w5e11264sgsg"_b36u64;
+//    constexpr auto b36d = "1z141z4"_b36u32;
+//    constexpr auto b32a = "ABCU"_b32u64;
+//    constexpr auto b32b = "G000000000000"_b32u64;
+//    constexpr auto tag1 = "RIF"_fourcc;
+//    constexpr auto tag2 = "ABCDEFGHI"_tag64;
+//    constexpr auto ip1 = "10.1.0.256"_ipv4;
+//    constexpr auto ip2 = "10.01.0.0"_ipv4;
+//    constexpr auto ip3 = "10.1.0.0/16"_ipv4;
+//    constexpr auto net1 = "10.1.0.0/33"_cidr4;
+//    constexpr auto net2 = "10.1.2.0/16"_cidr4;
+//    constexpr auto uuid1 = "123e4567-e89b-12d3-a456-42661417400"_uuid;
+//    constexpr auto uuid2 = "123e4567e89b-12d3-a456-4266141740000"_uuid;
+//    constexpr auto uuid3 = "123e4567-e89b-12d3-a456-42661417400g"_uuid;
+//    constexpr auto cpus1 = "0-3,"_cpuset;
+//    constexpr auto cpus2 = "0-1024"_cpuset;
+//    constexpr auto cpus3 = "8-3"_cpuset;
+  }
+
+  {
+    constexpr auto id1 = "zz9abc"_b36u64;
+    constexpr auto id2 = "ZZ9ABC"_b36u64;
+    constexpr auto id3 = "3w5e11264sgsf"_b36u64;
+    constexpr auto id4 = "1z141z3"_b36u32;
+
+    static_assert(id1 == 2175535992u, "xxx");
+    static_assert(id1 == id2, "xxx");
+    static_assert(id3 == UINT64_MAX, "xxx");
+    static_assert(id4 == UINT32_MAX, "xxx");
+    static_assert("0"_b36u64 == 0 && "00000000000000000000z"_b36u64 == 35, "xxx");
+    static_assert(std::is_same<const uint64_t, decltype(id1)>::value, "Broken");
+    static_assert(std::is_same<const uint32_t, decltype(id4)>::value, "Broken");
+  }
+
+  {
+    constexpr auto key1 = "3V"_b32u32;
+    constexpr auto key2 = "FZZZZZZZZZZZZ"_b32u64;
+
+    static_assert(key1 == 3 * 32 + 27, "xxx");
+    static_assert(key2 == UINT64_MAX, "xxx");
+    static_assert("3v"_b32u32 == key1, "xxx");
+    static_assert("1O"_b32u32 == "io"_b32u32 && "L0"_b32u32 == 32, "xxx");
+    static_assert("Z"_b32u32 == 31 && "J"_b32u32 == 18 && "V"_b32u32 == 27, "xxx");
+    static_assert(std::is_same<const uint64_t, decltype(key2)>::value, "Broken");
+  }
+
+  {
+    constexpr auto riff = "RIFF"_fourcc;
+    constexpr auto tag = "ABCDEFGH"_tag64;
+
+    static_assert(std::is_same<const uint32_t, decltype(riff)>::value, "Broken");
+    static_assert(std::is_same<const uint64_t, decltype(tag)>::value, "Broken");
+    static_assert("RIFF"_fourcc != "RIFX"_fourcc && "\xff\0\0\x01"_fourcc != 0, "xxx");
+
+    // Matches whatever a plain load of the same bytes gives on this host
+    const char header[] = "RIFF....WAVEfmt ABCDEFGH";
+    CHECK(intparse::loadTag32(header) == riff);
+    CHECK(intparse::loadTag32(header + 8) == "WAVE"_fourcc);
+    CHECK(intparse::loadTag32(header + 12) == "fmt "_fourcc);
+    CHECK(intparse::loadTag64(header + 16) == tag);
+    CHECK(intparse::loadTag32("\xff\0\0\x01") == "\xff\0\0\x01"_fourcc);
+  }
+
+  {
+    static_assert(distinctHashes({"get"_h64, "put"_h64, "post"_h64, "delete"_h64, "head"_h64}), "xxx");
+    static_assert(!distinctHashes({"get"_h64, "put"_h64, "get"_h64}), "xxx");
+    static_assert("content-length"_h64 != "content-lengtH"_h64 && "a"_h64 != "b"_h64, "xxx");
+
+    CHECK(headerIndex("content-length") == 1);
+    CHECK(headerIndex("content-type") == 2);
+    CHECK(headerIndex("host") == 3);
+    CHECK(headerIndex("") == 4);
+    CHECK(headerIndex("x-a-header-name-longer-than-sixteen") == 5);
+    CHECK(headerIndex("content-lengths") == 0);
+    CHECK(headerIndex("hos") == 0);
+  }
+
+  {
+    constexpr auto gateway = "10.1.0.1"_ipv4;
+    constexpr auto net = "10.1.0.0/16"_cidr4;
+
+    static_assert(std::is_same<const uint32_t, decltype(gateway)>::value, "Broken");
+    static_assert(net.contains(gateway) && !net.contains("10.2.0.1"_ipv4), "xxx");
+    static_assert(("0.0.0.0/0"_cidr4).contains("255.255.255.255"_ipv4), "xxx");
+    static_assert(("192.168.1.7/32"_cidr4).contains("192.168.1.7"_ipv4), "xxx");
+    static_assert(!("192.168.1.7/32"_cidr4).contains("192.168.1.6"_ipv4), "xxx");
+    static_assert(("10.1.0.0/16"_cidr4).mask == ("255.255.0.0"_ipv4), "xxx");
+
+    // Network byte order is the address bytes in memory order
+    const unsigned char bytes[4] = {10, 1, 0, 1};
+    uint32_t loaded = 0;
+    std::memcpy(&loaded, bytes, sizeof(loaded));
+    CHECK(loaded == gateway);
+  }
+
+  {
+    constexpr auto tenant = "123e4567-e89b-12d3-a456-426614174000"_uuid;
+
+    static_assert(std::is_same<const Uuid, decltype(tenant)>::value, "Broken");
+    static_assert(tenant.high == 0x123e4567e89b12d3u && tenant.low == 0xa456426614174000u, "xxx");
+    static_assert(tenant == "123E4567-E89B-12D3-A456-426614174000"_uuid, "xxx");
+    static_assert("00000000-0000-0000-0000-000000000000"_uuid < tenant, "xxx");
+    static_assert(("ffffffff-ffff-ffff-ffff-ffffffffffff"_uuid).low == UINT64_MAX, "xxx");
+
+    const char text[] = "123e4567-e89b-12d3-a456-426614174000";
+    Uuid parsed = {0, 0};
+    char formatted[intparse::kUuidChars];
+    CHECK(intparse::parseUuid(text, intparse::kUuidChars, parsed) == intparse::ParseError::None);
+    CHECK(parsed == tenant);
+    CHECK(intparse::formatUuid(tenant, formatted) == intparse::kUuidChars);
+    CHECK(std::memcmp(formatted, text, intparse::kUuidChars) == 0);
+  }
+
+  {
+    constexpr auto housekeeping = "0-3,8"_cpuset;
+
+    static_assert(std::is_same<const CpuSet, decltype(housekeeping)>::value, "Broken");
+    static_assert(housekeeping.words[0] == 0x10f && housekeeping.words[1] == 0, "xxx");
+    static_assert(housekeeping.contains(8) && !housekeeping.contains(4) && !housekeeping.contains(5000), "xxx");
+    static_assert(""_cpuset == CpuSet{}, "xxx");
+    static_assert("3,0-2"_cpuset == "0-3"_cpuset && "0-3"_cpuset != "0-4"_cpuset, "xxx");
+    static_assert(("60-130"_cpuset).words[0] == 0xf000000000000000u && ("60-130"_cpuset).words[1] == UINT64_MAX &&
+                      ("60-130"_cpuset).words[2] == 0x7, "xxx");
+    static_assert(("0-1023"_cpuset).words[15] == UINT64_MAX && ("1023"_cpuset).words[15] == 1ull << 63, "xxx");
+
+    // The runtime parser gives the same set
+    const char* const kLists[] = {"0-3,8", "", "60-130", "0-1023", "5,5,4-6", "0007-0009"};
+    const CpuSet kSets[] = {"0-3,8"_cpuset, ""_cpuset, "60-130"_cpuset, "0-1023"_cpuset, "5,5,4-6"_cpuset,
+                            "7-9"_cpuset};
+    for (std::size_t i = 0; i < sizeof(kLists) / sizeof(kLists[0]); ++i) {
+      CpuSet parsed = "1"_cpuset;
+      CHECK(intparse::parseCpuList(kLists[i], std::strlen(kLists[i]), parsed) == intparse::ParseError::None);
+      CHECK(parsed == kSets[i]);
+    }
+  }
+
+  // The runtime codecs read the same alphabets, so every literal parses back to itself
+  {
+    const char* const kBase36[] = {"0", "z", "zz9abc", "ZZ9ABC", "3w5e11264sgsf", "0000000000000000001"};
+    const uint64_t kBase36Values[] = {"0"_b36u64, "z"_b36u64, "zz9abc"_b36u64, "ZZ9ABC"_b36u64,
+                                      "3w5e11264sgsf"_b36u64, "0000000000000000001"_b36u64};
+    for (std::size_t i = 0; i < sizeof(kBase36) / sizeof(kBase36[0]); ++i) {
+      uint64_t value = 0;
+      CHECK(intparse::parseBase36(kBase36[i], std::string(kBase36[i]).size(), value) == intparse::ParseError::None);
+      CHECK(value == kBase36Values[i]);
+    }
+
+    const char* const kBase32[] = {"0", "3V", "1o", "IL", "FZZZZZZZZZZZZ", "ooooooooooooooooo7"};
+    const uint64_t kBase32Values[] = {"0"_b32u64, "3V"_b32u64, "1o"_b32u64, "IL"_b32u64, "FZZZZZZZZZZZZ"_b32u64,
+                                      "ooooooooooooooooo7"_b32u64};
+    for (std::size_t i = 0; i < sizeof(kBase32) / sizeof(kBase32[0]); ++i) {
+      uint64_t value = 0;
+      CHECK(intparse::parseBase32(kBase32[i], std::string(kBase32[i]).size(), value) == intparse::ParseError::None);
+      CHECK(value == kBase32Values[i]);
+    }
+  }
+
+  return gFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,299 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE
+#define SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE scw
+#endif
+
+#include "FixedWidthWideInt.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::intliterals;
+using namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::wideint;
+
+namespace {
+
+int gFailures = 0;
+const char* gContext = "";
+
+void check(bool ok, const char* what, int line) {
+  if (!ok) {
+    std::fprintf(stderr, "TestWideInt.cpp:%d: [%s] check failed: %s\n", line, gContext, what);
+    ++gFailures;
+  }
+}
+
+#define CHECK(cond_) check((cond_), #cond_, __LINE__)
+
+////////////////////////////////////////////////////////////////////////////////
+/// References that share nothing with the kernels: the product in 32-bit digits, and
+/// the remainder one bit at a time.
+template <std::size_t kLimbs>
+Limbs<2 * kLimbs> referenceMul(const Limbs<kLimbs>& a, const Limbs<kLimbs>& b) {
+  u64 digits[4 * kLimbs] = {};
+  for (std::size_t i = 0; i < 2 * kLimbs; ++i) {
+    u64 carry = 0;
+    const u64 bDigit = b[i / 2] >> (32 * (i % 2)) & 0xffffffffu;
+    for (std::size_t j = 0; j < 2 * kLimbs; ++j) {
+      const u64 aDigit = a[j / 2] >> (32 * (j % 2)) & 0xffffffffu;
+      const u64 term = aDigit * bDigit + (digits[i + j] & 0xffffffffu) + carry;
+      digits[i + j] = term & 0xffffffffu;
+      carry = term >> 32;
+    }
+    digits[i + 2 * kLimbs] = carry;
+  }
+  Limbs<2 * kLimbs> product = {};
+  for (std::size_t i = 0; i < 4 * kLimbs; ++i) {
+    product[i / 2] |= digits[i] << (32 * (i % 2));
+  }
+  return product;
+}
+
+template <std::size_t kLimbs, std::size_t kWide>
+Limbs<kLimbs> referenceMod(const Limbs<kWide>& value, const Limbs<kLimbs>& modulus) {
+  Limbs<kLimbs> r = {};
+  for (std::size_t bit = 64 * kWide; bit-- > 0;) {
+    const u64 top = r[kLimbs - 1] >> 63;
+    for (std::size_t i = kLimbs; i-- > 1;) {
+      r[i] = r[i] << 1 | r[i - 1] >> 63;
+    }
+    r[0] = r[0] << 1 | (value[bit / 64] >> (bit % 64) & 1);
+    Limbs<kLimbs> reduced = {};
+    if (sub(r, modulus, reduced) == 0 || top != 0) {
+      r = reduced;
+    }
+  }
+  return r;
+}
+
+template <std::size_t kLimbs>
+Limbs<kLimbs> randomLimbs(std::mt19937_64& rng) {
+  Limbs<kLimbs> value;
+  for (u64& limb : value) {
+    limb = rng() % 5 == 0 ? ~u64{0} : rng() % 5 == 0 ? 0 : rng();
+  }
+  return value;
+}
+
+template <std::size_t kLimbs>
+void testLimbs(std::mt19937_64& rng) {
+  namespace detail = SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::wideint::detail;
+  for (int trial = 0; trial < 300; ++trial) {
+    const Limbs<kLimbs> a = randomLimbs<kLimbs>(rng);
+    const Limbs<kLimbs> b = randomLimbs<kLimbs>(rng);
+    const Limbs<2 * kLimbs> expected = referenceMul(a, b);
+    CHECK(mul(a, b) == expected);
+    CHECK(detail::mulPortable(a, b) == expected);
+
+    Limbs<kLimbs> sum = {};
+    Limbs<kLimbs> back = {};
+    const u64 carry = add(a, b, sum);
+    CHECK(sub(sum, b, back) == carry && back == a);
+    CHECK((compare(a, b) < 0) == (sub(a, b, back) != 0));
+
+    // Odd, with the top bit set half the time, and both operands below it
+    Limbs<kLimbs> modulus = randomLimbs<kLimbs>(rng);
+    modulus[0] |= 1;
+    modulus[kLimbs - 1] |= trial % 2 == 0 ? u64{1} << 63 : u64{1};
+    Limbs<kLimbs> x = a;
+    Limbs<kLimbs> y = b;
+    x[kLimbs - 1] %= modulus[kLimbs - 1];
+    y[kLimbs - 1] %= modulus[kLimbs - 1];
+    const u64 inverse = montgomeryInverse(modulus[0]);
+    CHECK(modulus[0] * inverse == ~u64{0});
+
+    // x * y * R^-1 times R is x * y, mod the modulus
+    const Limbs<kLimbs> product = montgomeryMul(x, y, modulus, inverse);
+    Limbs<2 * kLimbs> shifted = {};
+    for (std::size_t i = 0; i < kLimbs; ++i) {
+      shifted[i + kLimbs] = product[i];
+    }
+    CHECK(compare(product, modulus) < 0);
+    CHECK(referenceMod(shifted, modulus) == referenceMod(mul(x, y), modulus));
+    CHECK(detail::montgomeryPortable(x, y, modulus, inverse) == product);
+#if SCW_WIDEINT_ADX_KERNELS
+    if (__builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx")) {
+      CHECK(detail::montgomeryAdx(x, y, modulus, inverse) == product);
+    }
+#endif
+
+    // In and out of Montgomery form is the identity
+    const Limbs<kLimbs> one = {1};
+    CHECK(montgomeryMul(montgomeryMul(x, montgomeryR2(modulus), modulus, inverse), one, modulus, inverse) == x);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Long decimal strings against the plain digit at a time fold. Lengths are picked
+/// around the chunk, the Horner cutoff and the Karatsuba cutoff, and up past where
+/// unbalanced products get sliced.
+LimbVector referenceDecimal(const std::string& text) {
+  LimbVector value;
+  for (char ch : text) {
+    u64 carry = static_cast<u64>(ch - '0');
+    for (u64& limb : value) {
+      const auto term = static_cast<SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::intparse::u128>(limb) * 10 + carry;
+      limb = static_cast<u64>(term);
+      carry = static_cast<u64>(term >> 64);
+    }
+    if (carry != 0) {
+      value.push_back(carry);
+    }
+  }
+  return value;
+}
+
+std::string randomDecimal(std::mt19937_64& rng, std::size_t length) {
+  std::string text(length, '0');
+  for (char& ch : text) {
+    ch = static_cast<char>('0' + (rng() % 7 == 0 ? (rng() % 2) * 9 : rng() % 10));
+  }
+  return text;
+}
+
+void testLongDecimal(std::mt19937_64& rng) {
+  using SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::intparse::ParseError;
+  std::vector<std::size_t> lengths = {1, 18, 19, 20, 38, 39, 19 * 32, 19 * 32 + 1, 19 * 33, 19 * 65,
+                                      19 * 64 * 5, 19 * 2048 + 1, 50000};
+  for (int i = 0; i < 40; ++i) {
+    lengths.push_back(1 + rng() % 4000);
+  }
+  for (std::size_t length : lengths) {
+    const std::string text = randomDecimal(rng, length);
+    LimbVector limbs;
+    CHECK(parseDecimal(text.data(), text.size(), limbs) == ParseError::None);
+    CHECK(limbs == referenceDecimal(text));
+    CHECK(limbs.empty() || limbs.back() != 0);
+  }
+
+  // All nines is 10^n - 1, whose top limbs are full; a one and zeros is 10^n exactly
+  for (std::size_t length : {19u * 32 * 4, 19u * 1024 + 7}) {
+    const std::string nines(length, '9');
+    const std::string power = "1" + std::string(length, '0');
+    LimbVector limbs;
+    CHECK(parseDecimal(nines.data(), nines.size(), limbs) == ParseError::None && limbs == referenceDecimal(nines));
+    CHECK(parseDecimal(power.data(), power.size(), limbs) == ParseError::None && limbs == referenceDecimal(power));
+  }
+
+  LimbVector limbs = {1};
+  const std::string zeros(100, '0');
+  CHECK(parseDecimal(zeros.data(), zeros.size(), limbs) == ParseError::None && limbs.empty());
+  CHECK(parseDecimal("", 0, limbs) == ParseError::Empty);
+  std::string bad = randomDecimal(rng, 3000);
+  bad[1234] = 'x';
+  CHECK(parseDecimal(bad.data(), bad.size(), limbs) == ParseError::InvalidDigit);
+
+  // Fixed width: the same values as the literals, overflow past the top limb
+  Limbs<2> value = {};
+  const std::string max128 = "340282366920938463463374607431768211455";
+  const std::string two128 = "340282366920938463463374607431768211456";
+  CHECK(parseDecimal(max128.data(), max128.size(), value) == ParseError::None && value == 0xffffffffffffffffffffffffffffffff_w128);
+  CHECK(parseDecimal(two128.data(), two128.size(), value) == ParseError::Overflow);
+  const std::string padded = zeros + max128;
+  CHECK(parseDecimal(padded.data(), padded.size(), value) == ParseError::None && value == 0xffffffffffffffffffffffffffffffff_w128);
+  const std::string overflowThenBad = two128 + "1x";
+  CHECK(parseDecimal(overflowThenBad.data(), overflowThenBad.size(), value) == ParseError::InvalidDigit);
+  CHECK(parseDecimal("", 0, value) == ParseError::Empty);
+  for (int i = 0; i < 200; ++i) {
+    const std::string text = randomDecimal(rng, 1 + rng() % 154);
+    Limbs<8> wide = {};
+    const LimbVector expected = referenceDecimal(text);
+    CHECK(parseDecimal(text.data(), text.size(), wide) == (expected.size() <= 8 ? ParseError::None : ParseError::Overflow));
+    for (std::size_t j = 0; j < expected.size() && expected.size() <= 8; ++j) {
+      CHECK(wide[j] == expected[j]);
+    }
+  }
+}
+
+}  // namespace
+
+int main() {
+
+  // These should cause a compile error if you uncomment them
+  {
+//    constexpr auto w1 = 0x100000000000000000000000000000000_w128;
+//    constexpr auto w2 = 340282366920938463463374607431768211456_w128;
+//    constexpr auto w3 = 0x100000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000_w512;
+  }
+
+  {
+    constexpr auto max128 = 0xffffffffffffffffffffffffffffffff_w128;
+    constexpr auto two64 = 18446744073709551616_w128;
+
+    static_assert(std::is_same<const Limbs<2>, decltype(max128)>::value, "Broken");
+    static_assert(std::is_same<Limbs<8>, decltype(0_w512)>::value, "Broken");
+    static_assert(compare(max128, Limbs<2>{{~0ull, ~0ull}}) == 0, "xxx");
+    static_assert(compare(max128, 340282366920938463463374607431768211455_w128) == 0, "xxx");
+    static_assert(compare(two64, Limbs<2>{{0, 1}}) == 0 && compare(two64, 0x10000000000000000_w128) == 0, "xxx");
+    static_assert(compare(0b11_w192, Limbs<3>{{3, 0, 0}}) == 0 && compare(0777_w256, Limbs<4>{{511, 0, 0, 0}}) == 0,
+                  "xxx");
+    static_assert(compare(0XABC_w320, 0xabc_w320) == 0 && compare(0B1_w384, 1_w384) == 0, "xxx");
+    static_assert(0x100000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000_w448[6] == u64{1} << 56,
+                  "xxx");
+  }
+
+  {
+    // Everything is constexpr, so literal-derived constants can be checked where they're defined
+    constexpr auto max128 = 0xffffffffffffffffffffffffffffffff_w128;
+    constexpr auto square = mul(max128, max128);  // 2^256 - 2^129 + 1
+    static_assert(compare(square, Limbs<4>{{1, 0, ~1ull, ~0ull}}) == 0, "xxx");
+
+    constexpr auto p256 = 0xffffffff00000001000000000000000000000000ffffffffffffffffffffffff_w256;
+    constexpr u64 inverse = montgomeryInverse(p256[0]);
+    static_assert(p256[0] * inverse == ~0ull, "xxx");
+    static_assert(inverse == 1, "xxx");  // P-256's low limb is all ones
+
+    // 2^256 mod p, the Montgomery form of one, comes back out as one
+    constexpr Limbs<4> one = {{1, 0, 0, 0}};
+    constexpr auto r2 = montgomeryR2(p256);
+    constexpr auto montOne = montgomeryMul(one, r2, p256, inverse);
+    static_assert(compare(montgomeryMul(montOne, one, p256, inverse), one) == 0, "xxx");
+    static_assert(compare(montgomeryMul(montOne, montOne, p256, inverse), montOne) == 0, "xxx");
+
+    constexpr Limbs<2> zero = {};
+    Limbs<2> sum = {};
+    CHECK(add(max128, 1_w128, sum) == 1 && sum == zero);
+    CHECK(sub(zero, 1_w128, sum) == 1 && sum == max128);
+  }
+
+  std::mt19937_64 rng(91);
+  gContext = "2";
+  testLimbs<2>(rng);
+  gContext = "3";
+  testLimbs<3>(rng);
+  gContext = "4";
+  testLimbs<4>(rng);
+  gContext = "5";
+  testLimbs<5>(rng);
+  gContext = "6";
+  testLimbs<6>(rng);
+  gContext = "7";
+  testLimbs<7>(rng);
+  gContext = "8";
+  testLimbs<8>(rng);
+  gContext = "decimal";
+  testLongDecimal(rng);
+
+  return gFailures == 0 ? 0 : 1;
+}
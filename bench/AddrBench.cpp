@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// Address text benchmarks: inet_pton and inet_ntop against the intparse kernels.
+///
+/// Usage: addr-bench [--addresses <n>] [--seed <n>] [--min-time-ms <ms>]
+///
+/// The corpora are what flow logs look like: IPv4 addresses of every width, and IPv6
+/// addresses with the zero runs, mapped addresses and short hextets real ones have,
+/// all written by inet_ntop. Every parse is checked against inet_pton's result and
+/// every format against inet_ntop's text, so the smoke test is a correctness check.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "FixedWidthIntParse.h"
+
+#include <arpa/inet.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+namespace intparse = SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::intparse;
+using u64 = std::uint64_t;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Each address is terminated, since inet_pton needs it to be.
+struct AddrCorpus {
+  int family;
+  std::string text;
+  std::vector<std::size_t> offsets;
+  std::vector<intparse::Ipv6Address> addresses;  // IPv4 addresses use the first four bytes
+};
+
+AddrCorpus generateCorpus(int family, std::size_t count, u64 seed) {
+  std::mt19937_64 rng(seed);
+  AddrCorpus corpus{family, std::string(), std::vector<std::size_t>(), std::vector<intparse::Ipv6Address>()};
+  for (std::size_t i = 0; i < count; ++i) {
+    intparse::Ipv6Address address = {};
+    if (family == AF_INET) {
+      const std::uint32_t host = static_cast<std::uint32_t>(rng() >> (rng() % 4 * 8));
+      std::memcpy(address.bytes, &host, sizeof(host));
+    } else if (rng() % 8 == 0) {
+      address.bytes[10] = address.bytes[11] = 0xff;
+      const std::uint32_t host = static_cast<std::uint32_t>(rng());
+      std::memcpy(address.bytes + 12, &host, sizeof(host));
+    } else {
+      // A prefix, then mostly zeros and a short interface id
+      const unsigned prefixWords = 2 + static_cast<unsigned>(rng() % 3);
+      for (unsigned w = 0; w < 8; ++w) {
+        const bool used = w < prefixWords || w == 7 || rng() % 4 == 0;
+        const unsigned word = used ? static_cast<unsigned>(rng() >> (rng() % 4 * 4 + 48)) : 0;
+        address.bytes[2 * w] = static_cast<std::uint8_t>(word >> 8);
+        address.bytes[2 * w + 1] = static_cast<std::uint8_t>(word);
+      }
+    }
+    char text[INET6_ADDRSTRLEN];
+    inet_ntop(family, address.bytes, text, sizeof(text));
+    corpus.offsets.push_back(corpus.text.size());
+    corpus.text.append(text, std::strlen(text) + 1);
+    corpus.addresses.push_back(address);
+  }
+  return corpus;
+}
+
+u64 checksumStep(u64 checksum, const void* bytes, std::size_t length) {
+  for (std::size_t i = 0; i < length; ++i) {
+    checksum = (checksum ^ static_cast<const unsigned char*>(bytes)[i]) * u64{0x100000001b3};
+  }
+  return checksum;
+}
+
+u64 addressBytes(int family) {
+  return family == AF_INET ? 4 : 16;
+}
+
+u64 expectedChecksum(const AddrCorpus& corpus) {
+  u64 checksum = 0;
+  for (const intparse::Ipv6Address& address : corpus.addresses) {
+    checksum = checksumStep(checksum, address.bytes, addressBytes(corpus.family));
+  }
+  return checksum;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Parsers return the checksum of the addresses; formatters the checksum of the text.
+u64 benchInetPton(const AddrCorpus& corpus) {
+  u64 checksum = 0;
+  for (std::size_t offset : corpus.offsets) {
+    unsigned char address[16];
+    inet_pton(corpus.family, corpus.text.data() + offset, address);
+    checksum = checksumStep(checksum, address, addressBytes(corpus.family));
+  }
+  return checksum;
+}
+
+template <intparse::Isa kIsa>
+u64 benchParse(const AddrCorpus& corpus) {
+  static const intparse::KernelTable table = intparse::resolveKernels(kIsa);
+  u64 checksum = 0;
+  for (std::size_t i = 0; i < corpus.offsets.size(); ++i) {
+    const char* text = corpus.text.data() + corpus.offsets[i];
+    const std::size_t length = (i + 1 < corpus.offsets.size() ? corpus.offsets[i + 1] : corpus.text.size()) -
+                               corpus.offsets[i] - 1;
+    intparse::Ipv6Address address;
+    if (corpus.family == AF_INET) {
+      std::uint32_t address4;
+      table.parseIpv4(text, length, address4);
+      std::memcpy(address.bytes, &address4, sizeof(address4));
+    } else {
+      table.parseIpv6(text, length, address);
+    }
+    checksum = checksumStep(checksum, address.bytes, addressBytes(corpus.family));
+  }
+  return checksum;
+}
+
+u64 benchInetNtop(const AddrCorpus& corpus) {
+  u64 checksum = 0;
+  for (const intparse::Ipv6Address& address : corpus.addresses) {
+    char text[INET6_ADDRSTRLEN];
+    inet_ntop(corpus.family, address.bytes, text, sizeof(text));
+    checksum = checksumStep(checksum, text, std::strlen(text));
+  }
+  return checksum;
+}
+
+u64 benchFormat(const AddrCorpus& corpus) {
+  u64 checksum = 0;
+  for (const intparse::Ipv6Address& address : corpus.addresses) {
+    char text[intparse::kMaxIpv6Chars];
+    std::uint32_t address4;
+    std::memcpy(&address4, address.bytes, sizeof(address4));
+    const std::size_t length =
+        corpus.family == AF_INET ? intparse::formatIpv4(address4, text) : intparse::formatIpv6(address, text);
+    checksum = checksumStep(checksum, text, length);
+  }
+  return checksum;
+}
+
+struct AddrBenchmark {
+  const char* name;
+  bool format;
+  u64 (*run)(const AddrCorpus&);
+};
+
+const AddrBenchmark kBenchmarks[] = {
+    {"inet_pton", false, benchInetPton},
+    {"intparse/scalar", false, benchParse<intparse::Isa::Scalar>},
+    {"intparse/sse41", false, benchParse<intparse::Isa::Sse41>},
+    {"inet_ntop", true, benchInetNtop},
+    {"intparse/format", true, benchFormat},
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t count = 1000000;
+  u64 seed = 1;
+  double minTimeMs = 200;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string arg = argv[i];
+    if (arg == "--addresses") {
+      count = std::strtoull(argv[i + 1], nullptr, 10);
+    } else if (arg == "--seed") {
+      seed = std::strtoull(argv[i + 1], nullptr, 10);
+    } else if (arg == "--min-time-ms") {
+      minTimeMs = std::strtod(argv[i + 1], nullptr);
+    } else {
+      std::fprintf(stderr, "usage: %s [--addresses <n>] [--seed <n>] [--min-time-ms <ms>]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  bool failed = false;
+  std::printf("%-7s %-20s %10s %10s %s\n", "family", "benchmark", "ns/addr", "MB/s", "check");
+  for (int family : {AF_INET, AF_INET6}) {
+    const AddrCorpus corpus = generateCorpus(family, count, seed);
+    const u64 expectedParse = expectedChecksum(corpus);
+    const u64 expectedFormat = benchInetNtop(corpus);
+
+    for (const AddrBenchmark& benchmark : kBenchmarks) {
+      using Clock = std::chrono::steady_clock;
+      double bestNs = 0;
+      double totalMs = 0;
+      bool matched = true;
+      do {
+        const Clock::time_point start = Clock::now();
+        const u64 checksum = benchmark.run(corpus);
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        matched = matched && checksum == (benchmark.format ? expectedFormat : expectedParse);
+        bestNs = bestNs == 0 || ns < bestNs ? ns : bestNs;
+        totalMs += ns / 1e6;
+      } while (totalMs < minTimeMs);
+
+      const double addresses = static_cast<double>(corpus.offsets.size());
+      const double textBytes = static_cast<double>(corpus.text.size()) - addresses;
+      std::printf("%-7s %-20s %10.2f %10.1f %s\n", family == AF_INET ? "ipv4" : "ipv6", benchmark.name,
+                  addresses == 0 ? 0.0 : bestNs / addresses, bestNs == 0 ? 0.0 : textBytes * 1e3 / bestNs,
+                  matched ? "ok" : "MISMATCH");
+      failed = failed || !matched;
+    }
+  }
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// Runs every registered parse benchmark over every corpus profile.
+///
+/// Usage: int-bench [--tokens <n>] [--seed <n>] [--min-time-ms <ms>] [--filter <substring>]
+///
+/// Each benchmark is repeated until it has run for at least --min-time-ms and the
+/// fastest pass is reported. A benchmark whose checksum doesn't match the corpus
+/// fails the run, so the smoke test doubles as a correctness check.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "IntBench.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+using namespace intbench;
+
+////////////////////////////////////////////////////////////////////////////////
+/// The baselines everything else gets compared to.
+u64 benchStrtoull(const Corpus& corpus) {
+  u64 checksum = 0;
+  char buffer[72];
+  for (const Token& token : corpus.tokens) {
+    // Trace ids put two tokens back to back, so the digits have to be cut out
+    std::memcpy(buffer, corpus.text.data() + token.offset, token.length);
+    buffer[token.length] = '\0';
+    checksum = checksumStep(checksum, std::strtoull(buffer, nullptr, token.radix));
+  }
+  return checksum;
+}
+
+u64 benchNaiveLoop(const Corpus& corpus) {
+  u64 checksum = 0;
+  for (const Token& token : corpus.tokens) {
+    const char* digits = corpus.text.data() + token.offset;
+    u64 value = 0;
+    for (unsigned i = 0; i < token.length; ++i) {
+      const char ch = digits[i];
+      value = value * token.radix + static_cast<u64>(ch <= '9' ? ch - '0' : (ch | 0x20) - 'a' + 10);
+    }
+    checksum = checksumStep(checksum, value);
+  }
+  return checksum;
+}
+
+INTBENCH_REGISTER(strtoull, benchStrtoull);
+INTBENCH_REGISTER(naive-loop, benchNaiveLoop);
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t tokenCount = 1000000;
+  u64 seed = 1;
+  double minTimeMs = 200;
+  std::string filter;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string arg = argv[i];
+    if (arg == "--tokens") {
+      tokenCount = std::strtoull(argv[i + 1], nullptr, 10);
+    } else if (arg == "--seed") {
+      seed = std::strtoull(argv[i + 1], nullptr, 10);
+    } else if (arg == "--min-time-ms") {
+      minTimeMs = std::strtod(argv[i + 1], nullptr);
+    } else if (arg == "--filter") {
+      filter = argv[i + 1];
+    } else {
+      std::fprintf(stderr, "usage: %s [--tokens <n>] [--seed <n>] [--min-time-ms <ms>] [--filter <substring>]\n",
+                   argv[0]);
+      return 2;
+    }
+  }
+
+  bool failed = false;
+  std::printf("%-11s %-28s %10s %10s %s\n", "profile", "benchmark", "ns/token", "MB/s", "check");
+  for (Profile profile : kAllProfiles) {
+    const Corpus corpus = generateCorpus(profile, tokenCount, seed);
+    const u64 expected = checksumOf(corpus.values);
+
+    for (const Benchmark& benchmark : registry()) {
+      if (!filter.empty() && std::strstr(benchmark.name, filter.c_str()) == nullptr) {
+        continue;
+      }
+
+      using Clock = std::chrono::steady_clock;
+      double bestNs = 0;
+      double totalMs = 0;
+      bool matched = true;
+      do {
+        const Clock::time_point start = Clock::now();
+        const u64 checksum = benchmark.run(corpus);
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        matched = matched && checksum == expected;
+        bestNs = bestNs == 0 || ns < bestNs ? ns : bestNs;
+        totalMs += ns / 1e6;
+      } while (totalMs < minTimeMs);
+
+      const double tokens = static_cast<double>(corpus.tokens.size());
+      std::printf("%-11s %-28s %10.2f %10.1f %s\n", profileName(profile), benchmark.name,
+                  tokens == 0 ? 0.0 : bestNs / tokens,
+                  bestNs == 0 ? 0.0 : static_cast<double>(corpus.text.size()) * 1e3 / bestNs,
+                  matched ? "ok" : "MISMATCH");
+      failed = failed || !matched;
+    }
+  }
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,262 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// Parse context benchmarks: many threads each parsing batches of the same shape, with
+/// their output in std::vectors from the global allocator against in their own
+/// thread's ParseContext arena.
+///
+/// Usage: context-bench [--tokens <n>] [--batches <n>] [--threads <n,n,...>] [--seed <n>] [--min-time-ms <ms>]
+///
+/// A batch is --tokens decimals from the log corpus, and every thread parses --batches
+/// of them after one to warm up. Allocations are counted by replacing operator new for
+/// the program, per thread, over the timed batches only. Every thread's values are
+/// checked against the corpus, and a context run that allocates at all fails, so the
+/// smoke test is a correctness check.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "FixedWidthIntParse.h"
+#include "IntCorpus.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+thread_local std::size_t tAllocations = 0;
+
+}  // namespace
+
+void* operator new(std::size_t bytes) {
+  ++tAllocations;
+  void* memory = std::malloc(bytes != 0 ? bytes : 1);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+void operator delete(void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+namespace {
+
+namespace intparse = SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::intparse;
+using namespace intbench;
+
+struct TokenText {
+  const char* text;
+  std::size_t length;
+
+  const char* data() const { return text; }
+  std::size_t size() const { return length; }
+};
+
+/// One batch's worth of tokens and what they sum to.
+struct Batch {
+  std::string text;
+  std::vector<TokenText> tokens;
+  u64 sum;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// The output of every batch in memory of its own, as callers without a context do.
+u64 parseVector(const Batch& batch) {
+  std::vector<u64> values(batch.tokens.size());
+  std::vector<intparse::ParseError> errors(batch.tokens.size());
+  intparse::parseDecimalBatch(batch.tokens.data(), batch.tokens.size(), values.data(), errors.data());
+  u64 sum = 0;
+  for (u64 value : values) {
+    sum += value;
+  }
+  return sum;
+}
+
+/// The same into the thread's context, which is reset once the batch is used.
+u64 parseContext(const Batch& batch) {
+  intparse::ParseContext& context = intparse::ParseContext::local();
+  u64 sum = 0;
+  {
+    const intparse::DecimalColumn<u64> column =
+        intparse::parseDecimalColumn<u64>(context, batch.tokens.data(), batch.tokens.size());
+    for (u64 value : column.values) {
+      sum += value;
+    }
+  }
+  context.reset();
+  return sum;
+}
+
+/// Straight from the newline separated text, with no token array at all.
+u64 parseContextText(const Batch& batch) {
+  intparse::ParseContext& context = intparse::ParseContext::local();
+  u64 sum = 0;
+  {
+    const intparse::DecimalColumn<u64> column =
+        intparse::parseDecimalColumn<u64>(context, batch.text.data(), batch.text.size(), '\n');
+    for (u64 value : column.values) {
+      sum += value;
+    }
+  }
+  context.reset();
+  return sum;
+}
+
+struct ContextBenchmark {
+  const char* name;
+  u64 (*run)(const Batch&);
+  bool allocationFree;
+};
+
+const ContextBenchmark kBenchmarks[] = {
+    {"std-vector", parseVector, false},
+    {"context", parseContext, true},
+    {"context-text", parseContextText, true},
+};
+
+/// What one thread saw over its timed batches.
+struct ThreadResult {
+  bool matched;
+  std::size_t allocations;
+};
+
+/// One pass: every thread warms up, then all of them run their batches at once.
+double runPass(const ContextBenchmark& benchmark, const Batch& batch, std::size_t threadCount, std::size_t batches,
+               std::vector<ThreadResult>& results) {
+  using Clock = std::chrono::steady_clock;
+  std::atomic<std::size_t> ready(0);
+  std::atomic<bool> go(false);
+  results.assign(threadCount, ThreadResult{true, 0});
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount);
+  for (std::size_t t = 0; t < threadCount; ++t) {
+    threads.emplace_back([&, t] {
+      ThreadResult& result = results[t];
+      result.matched = benchmark.run(batch) == batch.sum;
+      ready.fetch_add(1);
+      while (!go.load()) {
+        std::this_thread::yield();
+      }
+      const std::size_t before = tAllocations;
+      for (std::size_t i = 0; i < batches; ++i) {
+        result.matched = benchmark.run(batch) == batch.sum && result.matched;
+      }
+      result.allocations = tAllocations - before;
+    });
+  }
+  while (ready.load() != threadCount) {
+    std::this_thread::yield();
+  }
+  const Clock::time_point start = Clock::now();
+  go.store(true);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t tokenCount = 4096;
+  std::size_t batches = 256;
+  std::vector<std::size_t> threadCounts = {1, 2, 4, 8, 16, 32, 64};
+  u64 seed = 1;
+  double minTimeMs = 200;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string arg = argv[i];
+    if (arg == "--tokens") {
+      tokenCount = std::strtoull(argv[i + 1], nullptr, 10);
+    } else if (arg == "--batches") {
+      batches = std::strtoull(argv[i + 1], nullptr, 10);
+    } else if (arg == "--threads") {
+      threadCounts.clear();
+      for (char* p = argv[i + 1]; *p != '\0'; p += *p == ',' ? 1 : 0) {
+        threadCounts.push_back(std::strtoull(p, &p, 10));
+      }
+    } else if (arg == "--seed") {
+      seed = std::strtoull(argv[i + 1], nullptr, 10);
+    } else if (arg == "--min-time-ms") {
+      minTimeMs = std::strtod(argv[i + 1], nullptr);
+    } else {
+      std::fprintf(stderr,
+                   "usage: %s [--tokens <n>] [--batches <n>] [--threads <n,n,...>] [--seed <n>] [--min-time-ms <ms>]\n",
+                   argv[0]);
+      return 2;
+    }
+  }
+
+  const Corpus corpus = generateCorpus(Profile::Log, tokenCount, seed);
+  Batch batch;
+  batch.sum = 0;
+  for (const Token& token : corpus.tokens) {
+    batch.text.append(corpus.text, token.offset, token.length);
+    batch.text += '\n';
+  }
+  for (std::size_t i = 0, offset = 0; i < corpus.tokens.size(); offset += corpus.tokens[i++].length + 1) {
+    batch.tokens.push_back(TokenText{batch.text.data() + offset, corpus.tokens[i].length});
+    batch.sum += corpus.values[i];
+  }
+
+  bool failed = false;
+  std::printf("%-7s %-14s %10s %10s %14s %s\n", "threads", "benchmark", "ns/token", "Mtokens/s", "allocs/batch",
+              "check");
+  for (std::size_t threadCount : threadCounts) {
+    for (const ContextBenchmark& benchmark : kBenchmarks) {
+      double bestNs = 0;
+      double totalMs = 0;
+      bool matched = true;
+      std::size_t allocations = 0;
+      std::size_t passes = 0;
+      std::vector<ThreadResult> results;
+      do {
+        const double ns = runPass(benchmark, batch, threadCount, batches, results);
+        for (const ThreadResult& result : results) {
+          matched = matched && result.matched;
+          allocations += result.allocations;
+        }
+        bestNs = bestNs == 0 || ns < bestNs ? ns : bestNs;
+        totalMs += ns / 1e6;
+        ++passes;
+      } while (totalMs < minTimeMs);
+
+      matched = matched && (!benchmark.allocationFree || allocations == 0);
+      const double tokens = static_cast<double>(threadCount * batches * batch.tokens.size());
+      std::printf("%-7zu %-14s %10.2f %10.1f %14.2f %s\n", threadCount, benchmark.name,
+                  tokens == 0 ? 0.0 : bestNs / tokens, bestNs == 0 ? 0.0 : tokens * 1e3 / bestNs,
+                  static_cast<double>(allocations) / static_cast<double>(passes * threadCount * batches),
+                  matched ? "ok" : "MISMATCH");
+      failed = failed || !matched;
+    }
+  }
+  return failed ? 1 : 0;
+}
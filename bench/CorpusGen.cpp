@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// Command line front end for IntCorpus.h. Writes a corpus to a file so it can be
+/// inspected, shared, or fed to other tools.
+///
+/// Usage:
+///   int-corpus-gen --profile <log|trace|csv|binarymask> [--count <tokens>] [--seed <n>]
+///                  [--digits <min>-<max>] [--repeat <percent>] [--pool <codes>]
+///                  [--wide <percent>] [--separators <chars>] [--per-line <tokens>]
+///                  [--out <file>] [--index <file>]
+///
+/// The overrides replace the corresponding knob of the profile preset; --digits makes
+/// every length in the range equally likely. --index writes "offset length radix value"
+/// for each token next to the text.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "IntCorpus.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+int main(int argc, char* argv[]) {
+  using namespace intbench;
+
+  ProfileConfig config;
+  bool haveProfile = false;
+  std::size_t count = 100000;
+  u64 seed = 1;
+  std::string outPath;
+  std::string indexPath;
+
+  // The preset has to be known before any override is applied to it
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (std::string(argv[i]) == "--profile") {
+      Profile profile = Profile::Log;
+      haveProfile = profileFromName(argv[i + 1], profile);
+      if (haveProfile) {
+        config = defaultConfig(profile);
+      }
+    }
+  }
+
+  for (int i = 1; i < argc && haveProfile; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      haveProfile = false;
+      break;
+    }
+    const char* value = argv[++i];
+    if (arg == "--profile") {
+      continue;
+    } else if (arg == "--count") {
+      count = std::strtoull(value, nullptr, 10);
+    } else if (arg == "--seed") {
+      seed = std::strtoull(value, nullptr, 10);
+    } else if (arg == "--digits") {
+      char* end = nullptr;
+      const unsigned low = static_cast<unsigned>(std::strtoul(value, &end, 10));
+      const unsigned high = *end == '-' ? static_cast<unsigned>(std::strtoul(end + 1, nullptr, 10)) : low;
+      config.lengths.assign(high + 1, 0);
+      for (unsigned length = low == 0 ? 1 : low; length <= high; ++length) {
+        config.lengths[length] = 1;
+      }
+    } else if (arg == "--repeat") {
+      config.repeatPercent = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+    } else if (arg == "--pool") {
+      config.poolSize = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+    } else if (arg == "--wide") {
+      config.widePercent = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+    } else if (arg == "--separators") {
+      config.separators = value;
+    } else if (arg == "--per-line") {
+      config.tokensPerLine = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+    } else if (arg == "--out") {
+      outPath = value;
+    } else if (arg == "--index") {
+      indexPath = value;
+    } else {
+      haveProfile = false;
+    }
+  }
+
+  if (!haveProfile || config.separators.empty()) {
+    std::fprintf(stderr,
+                 "usage: %s --profile <log|trace|csv|binarymask> [--count <tokens>] [--seed <n>]\n"
+                 "       [--digits <min>-<max>] [--repeat <percent>] [--pool <codes>] [--wide <percent>]\n"
+                 "       [--separators <chars>] [--per-line <tokens>] [--out <file>] [--index <file>]\n",
+                 argv[0]);
+    return 2;
+  }
+
+  const Corpus corpus = generateCorpus(config, count, seed);
+  if (outPath.empty()) {
+    std::fwrite(corpus.text.data(), 1, corpus.text.size(), stdout);
+  } else {
+    std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+    out << corpus.text;
+    if (!out) {
+      std::fprintf(stderr, "int-corpus-gen: can't write %s\n", outPath.c_str());
+      return 1;
+    }
+  }
+
+  if (!indexPath.empty()) {
+    std::ofstream index(indexPath, std::ios::trunc);
+    for (std::size_t i = 0; i < corpus.tokens.size(); ++i) {
+      const Token& token = corpus.tokens[i];
+      index << token.offset << ' ' << token.length << ' ' << unsigned{token.radix} << ' ' << corpus.values[i]
+            << '\n';
+    }
+    if (!index) {
+      std::fprintf(stderr, "int-corpus-gen: can't write %s\n", indexPath.c_str());
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// 128-bit formatting benchmarks: the intparse formatters against a digit at a time
+/// loop of 128-bit divisions, which is what formatting __int128 usually comes down to.
+///
+/// Usage: int128-bench [--values <n>] [--seed <n>] [--min-time-ms <ms>]
+///
+/// Values are spread over every bit width, so short ones take the one-limb path as
+/// often as they would in practice. Only the formatting is timed. Every run's text is
+/// checked against the loop's, outside the clock, so the smoke test is a correctness
+/// check.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "FixedWidthIntParse.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+namespace intparse = SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::intparse;
+using u64 = std::uint64_t;
+using intparse::u128;
+
+/// Values are formatted a chunk at a time into a buffer that stays in cache, and only
+/// the formatting is timed; the text is checked after each chunk's clock stops, so the
+/// check costs neither side anything.
+const std::size_t kChunkValues = 1024;
+
+u64 checksumStep(u64 checksum, const char* text, std::size_t length) {
+  checksum = checksum * 31 + length;
+  for (std::size_t i = 0; i < length; i += 8) {
+    u64 word = 0;
+    std::memcpy(&word, text + i, length - i < 8 ? length - i : 8);
+    checksum = checksum * 31 + word;
+  }
+  return checksum;
+}
+
+template <unsigned kRadix>
+std::size_t formatNaive(u128 value, char* out) {
+  char buffer[intparse::kMaxBinary128Chars];
+  char* p = buffer + sizeof(buffer);
+  do {
+    *--p = "0123456789abcdef"[static_cast<unsigned>(value % kRadix)];
+    value /= kRadix;
+  } while (value != 0);
+  const std::size_t length = static_cast<std::size_t>(buffer + sizeof(buffer) - p);
+  std::memcpy(out, p, length);
+  return length;
+}
+
+/// The formatting time, in ns, and the checksum of the text.
+struct FormatRun {
+  double ns;
+  u64 checksum;
+};
+
+template <std::size_t (*kFormat)(u128, char*)>
+FormatRun benchFormat(const std::vector<u128>& values) {
+  using Clock = std::chrono::steady_clock;
+  static char text[kChunkValues][intparse::kMaxBinary128Chars];
+  std::size_t lengths[kChunkValues];
+  FormatRun run = {0, 0};
+  for (std::size_t base = 0; base < values.size(); base += kChunkValues) {
+    const std::size_t count = values.size() - base < kChunkValues ? values.size() - base : kChunkValues;
+    const Clock::time_point start = Clock::now();
+    for (std::size_t i = 0; i < count; ++i) {
+      lengths[i] = kFormat(values[base + i], text[i]);
+    }
+    run.ns += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    for (std::size_t i = 0; i < count; ++i) {
+      run.checksum = checksumStep(run.checksum, text[i], lengths[i]);
+    }
+  }
+  return run;
+}
+
+std::size_t formatDecimal(u128 value, char* out) {
+  return intparse::formatDecimal128(value, out);
+}
+
+/// The naive loop is also the reference each benchmark's text has to match.
+struct Int128Benchmark {
+  const char* radix;
+  const char* name;
+  FormatRun (*run)(const std::vector<u128>&);
+  FormatRun (*reference)(const std::vector<u128>&);
+};
+
+const Int128Benchmark kBenchmarks[] = {
+    {"decimal", "naive-division", benchFormat<formatNaive<10>>, benchFormat<formatNaive<10>>},
+    {"decimal", "intparse", benchFormat<formatDecimal>, benchFormat<formatNaive<10>>},
+    {"hex", "naive-division", benchFormat<formatNaive<16>>, benchFormat<formatNaive<16>>},
+    {"hex", "intparse", benchFormat<intparse::formatHex128>, benchFormat<formatNaive<16>>},
+    {"binary", "naive-division", benchFormat<formatNaive<2>>, benchFormat<formatNaive<2>>},
+    {"binary", "intparse", benchFormat<intparse::formatBinary128>, benchFormat<formatNaive<2>>},
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t count = 1000000;
+  u64 seed = 1;
+  double minTimeMs = 200;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string arg = argv[i];
+    if (arg == "--values") {
+      count = std::strtoull(argv[i + 1], nullptr, 10);
+    } else if (arg == "--seed") {
+      seed = std::strtoull(argv[i + 1], nullptr, 10);
+    } else if (arg == "--min-time-ms") {
+      minTimeMs = std::strtod(argv[i + 1], nullptr);
+    } else {
+      std::fprintf(stderr, "usage: %s [--values <n>] [--seed <n>] [--min-time-ms <ms>]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  // Mixed values are any width; full ones are within a byte of 128 bits
+  bool failed = false;
+  std::printf("%-6s %-8s %-16s %10s %s\n", "values", "radix", "benchmark", "ns/value", "check");
+  for (unsigned shifts : {128u, 8u}) {
+    std::mt19937_64 rng(seed);
+    std::vector<u128> values(count);
+    for (u128& value : values) {
+      value = (static_cast<u128>(rng()) << 64 | rng()) >> (rng() % shifts);
+    }
+
+    for (const Int128Benchmark& benchmark : kBenchmarks) {
+      const u64 expected = benchmark.reference(values).checksum;
+      double bestNs = 0;
+      double totalMs = 0;
+      bool matched = true;
+      do {
+        const FormatRun run = benchmark.run(values);
+        const double ns = run.ns;
+        matched = matched && run.checksum == expected;
+        bestNs = bestNs == 0 || ns < bestNs ? ns : bestNs;
+        totalMs += ns / 1e6;
+      } while (totalMs < minTimeMs);
+
+      std::printf("%-6s %-8s %-16s %10.2f %s\n", shifts == 128 ? "mixed" : "full", benchmark.radix, benchmark.name,
+                  values.empty() ? 0.0 : bestNs / static_cast<double>(values.size()), matched ? "ok" : "MISMATCH");
+      failed = failed || !matched;
+    }
+  }
+  return failed ? 1 : 0;
+}
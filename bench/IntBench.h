@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// Registry for the runtime parse benchmarks. Every registered benchmark runs over
+/// every corpus profile from IntCorpus.h; none of them get to pick their input.
+///
+/// A benchmark parses all tokens of the corpus and returns checksumOf() the values it
+/// produced, which the harness compares against the corpus' expected values.
+///
+///  INTBENCH_REGISTER(strtoull, [](const intbench::Corpus& corpus) { ... });
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "IntCorpus.h"
+
+#include <vector>
+
+namespace intbench {
+
+using BenchFunc = u64 (*)(const Corpus&);
+
+struct Benchmark {
+  const char* name;
+  BenchFunc run;
+};
+
+inline std::vector<Benchmark>& registry() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+struct Registrar {
+  Registrar(const char* name, BenchFunc run) { registry().push_back(Benchmark{name, run}); }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Order-dependent so a parser can't pass by producing the right values in the wrong slots.
+inline u64 checksumStep(u64 checksum, u64 value) {
+  return (checksum ^ value) * u64{0x100000001b3};
+}
+
+inline u64 checksumOf(const std::vector<u64>& values) {
+  u64 checksum = 0;
+  for (u64 value : values) {
+    checksum = checksumStep(checksum, value);
+  }
+  return checksum;
+}
+
+}  // namespace intbench
+
+#define INTBENCH_CONCAT_INNER(a_, b_) a_##b_
+#define INTBENCH_CONCAT(a_, b_) INTBENCH_CONCAT_INNER(a_, b_)
+#define INTBENCH_REGISTER(name_, func_) \
+  static ::intbench::Registrar INTBENCH_CONCAT(intbenchRegistrar, __LINE__)(#name_, func_)
@@ -0,0 +1,253 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// Synthesizes integer-text corpora that look like what we actually parse, so that
+/// benchmarks aren't flattered by uniformly random numbers.
+///
+/// Profiles
+/// --------
+///  log         - short decimals with a lot of repeated codes (status codes, ports)
+///  trace       - fixed-width 16 and 32 char hex ids; a 32 char id is two 64-bit tokens
+///  csv         - decimals of mixed widths separated by commas, rows ended by newlines
+///  binarymask  - 0b-prefixed 8/16/32/64 bit masks with leading zeros kept
+///
+/// A corpus is the text plus the position, radix and expected value of every token,
+/// so benchmarks can both time a parser and check its answers. Generation uses only
+/// std::mt19937_64 and integer math, so a given seed gives the same bytes everywhere.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace intbench {
+
+using u64 = std::uint64_t;
+
+enum class Profile { Log, Trace, Csv, BinaryMask };
+
+const Profile kAllProfiles[] = {Profile::Log, Profile::Trace, Profile::Csv, Profile::BinaryMask};
+
+inline const char* profileName(Profile profile) {
+  switch (profile) {
+    case Profile::Log: return "log";
+    case Profile::Trace: return "trace";
+    case Profile::Csv: return "csv";
+    case Profile::BinaryMask: return "binarymask";
+  }
+  return "?";
+}
+
+inline bool profileFromName(const char* name, Profile& profile) {
+  for (Profile candidate : kAllProfiles) {
+    if (std::strcmp(name, profileName(candidate)) == 0) {
+      profile = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// One number in the corpus text. offset/length cover the digits only, without any
+/// radix prefix, so kernels can be handed exactly the digits they parse.
+struct Token {
+  std::uint32_t offset;
+  std::uint16_t length;
+  std::uint8_t radix;
+};
+
+struct Corpus {
+  Profile profile;
+  std::string text;
+  std::vector<Token> tokens;
+  std::vector<u64> values;  // Expected value of each token
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Everything that shapes a profile. The presets come from defaultConfig(), and the
+/// generator tool lets each knob be overridden.
+struct ProfileConfig {
+  Profile profile = Profile::Log;
+  unsigned radix = 10;
+  std::string prefix;             // Written before every token, e.g. "0b"
+  std::vector<unsigned> lengths;  // Relative weight of each digit count; index is the count
+  bool keepLeadingZeros = false;  // Fixed-width ids and masks are written zero-padded
+  unsigned repeatPercent = 0;     // Chance a token repeats a value from the code pool
+  unsigned poolSize = 0;          // Number of distinct repeated codes
+  unsigned widePercent = 0;       // Chance of a double-width token written as two halves
+  std::string separators = " ";   // One is picked at random between tokens
+  unsigned tokensPerLine = 8;     // A newline replaces the separator this often
+};
+
+inline ProfileConfig defaultConfig(Profile profile) {
+  ProfileConfig config;
+  config.profile = profile;
+  switch (profile) {
+    case Profile::Log:
+      config.lengths = {0, 30, 25, 25, 10, 6, 4};
+      config.repeatPercent = 50;
+      config.poolSize = 16;
+      config.tokensPerLine = 6;
+      break;
+    case Profile::Trace:
+      config.radix = 16;
+      config.lengths.assign(17, 0);
+      config.lengths[16] = 1;
+      config.keepLeadingZeros = true;
+      config.widePercent = 50;
+      config.tokensPerLine = 3;
+      break;
+    case Profile::Csv:
+      config.lengths = {0, 10, 10, 10, 10, 10, 8, 8, 6, 6, 6, 4, 4, 3, 3, 2, 2, 1, 1, 1};
+      config.repeatPercent = 10;
+      config.poolSize = 64;
+      config.separators = ",";
+      config.tokensPerLine = 8;
+      break;
+    case Profile::BinaryMask:
+      config.radix = 2;
+      config.prefix = "0b";
+      config.lengths.assign(65, 0);
+      config.lengths[8] = 4;
+      config.lengths[16] = 3;
+      config.lengths[32] = 2;
+      config.lengths[64] = 1;
+      config.keepLeadingZeros = true;
+      config.tokensPerLine = 4;
+      break;
+  }
+  return config;
+}
+
+namespace detail {
+
+inline unsigned pickLength(std::mt19937_64& rng, const std::vector<unsigned>& weights) {
+  u64 total = 0;
+  for (unsigned weight : weights) {
+    total += weight;
+  }
+  u64 pick = total == 0 ? 0 : rng() % total;
+  for (unsigned length = 0; length < weights.size(); ++length) {
+    if (pick < weights[length]) {
+      return length;
+    }
+    pick -= weights[length];
+  }
+  return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// A value with exactly `digits` digits in radix (or at most, with leading zeros kept).
+inline u64 makeValue(std::mt19937_64& rng, unsigned radix, unsigned digits, bool keepLeadingZeros) {
+  u64 value = 0;
+  for (unsigned i = 0; i < digits; ++i) {
+    u64 digit = rng() % radix;
+    if (i == 0 && !keepLeadingZeros && digits > 1 && digit == 0) {
+      digit = 1 + rng() % (radix - 1);
+    }
+    value = value * radix + digit;
+  }
+  return value;
+}
+
+inline void appendDigits(std::string& text, u64 value, unsigned radix, unsigned width) {
+  static const char kDigitChars[] = "0123456789abcdef";
+  char buffer[64];
+  unsigned count = 0;
+  do {
+    buffer[count++] = kDigitChars[value % radix];
+    value /= radix;
+  } while (value != 0);
+  while (count < width) {
+    buffer[count++] = '0';
+  }
+  while (count != 0) {
+    text.push_back(buffer[--count]);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Largest digit count that always fits in 64 bits for the radix.
+inline unsigned maxDigitsFor(unsigned radix) {
+  return radix == 2 ? 64 : radix == 8 ? 21 : radix == 16 ? 16 : 19;
+}
+
+}  // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////
+/// Produces tokenCount tokens of the configured shape. A wide token counts as two.
+inline Corpus generateCorpus(const ProfileConfig& config, std::size_t tokenCount, u64 seed) {
+  std::mt19937_64 rng(seed);
+  Corpus corpus;
+  corpus.profile = config.profile;
+  corpus.tokens.reserve(tokenCount);
+  corpus.values.reserve(tokenCount);
+
+  const unsigned maxDigits = detail::maxDigitsFor(config.radix);
+  std::vector<std::pair<u64, unsigned>> pool;
+  for (unsigned i = 0; i < config.poolSize; ++i) {
+    const unsigned digits = std::min(detail::pickLength(rng, config.lengths), maxDigits);
+    pool.emplace_back(detail::makeValue(rng, config.radix, digits, config.keepLeadingZeros), digits);
+  }
+
+  std::size_t onLine = 0;
+  while (corpus.tokens.size() < tokenCount) {
+    if (!corpus.tokens.empty()) {
+      if (config.tokensPerLine != 0 && ++onLine == config.tokensPerLine) {
+        corpus.text.push_back('\n');
+        onLine = 0;
+      } else {
+        corpus.text.push_back(config.separators[rng() % config.separators.size()]);
+      }
+    }
+    corpus.text += config.prefix;
+
+    const bool repeat = !pool.empty() && rng() % 100 < config.repeatPercent;
+    const bool wide = !repeat && rng() % 100 < config.widePercent && tokenCount - corpus.tokens.size() >= 2;
+    const std::pair<u64, unsigned> picked =
+        repeat ? pool[rng() % pool.size()] : std::pair<u64, unsigned>{0, 0};
+    for (int half = 0; half < (wide ? 2 : 1); ++half) {
+      unsigned digits = repeat ? picked.second : std::min(detail::pickLength(rng, config.lengths), maxDigits);
+      digits = digits == 0 ? 1 : digits;
+      const u64 value = repeat ? picked.first : detail::makeValue(rng, config.radix, digits, config.keepLeadingZeros);
+      const std::size_t offset = corpus.text.size();
+      detail::appendDigits(corpus.text, value, config.radix, config.keepLeadingZeros ? digits : 0);
+      corpus.tokens.push_back(Token{static_cast<std::uint32_t>(offset),
+                                    static_cast<std::uint16_t>(corpus.text.size() - offset),
+                                    static_cast<std::uint8_t>(config.radix)});
+      corpus.values.push_back(value);
+    }
+  }
+  corpus.text.push_back('\n');
+  return corpus;
+}
+
+inline Corpus generateCorpus(Profile profile, std::size_t tokenCount, u64 seed) {
+  return generateCorpus(defaultConfig(profile), tokenCount, seed);
+}
+
+}  // namespace intbench
@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// FixedWidthIntParse.h kernels, one benchmark per tier plus the dispatched entry
+/// points. A tier the CPU lacks runs the best one it has, as dispatch would.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "IntBench.h"
+
+#include "FixedWidthIntParse.h"
+
+#include <algorithm>
+
+namespace {
+
+using namespace intbench;
+namespace intparse = SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::intparse;
+
+template <intparse::Isa kIsa>
+u64 benchTier(const Corpus& corpus) {
+  static const intparse::KernelTable table = intparse::resolveKernels(kIsa);
+  const intparse::ParseKernel kernel =
+      corpus.tokens.empty() || corpus.tokens[0].radix == 10 ? table.parseDecimal
+      : corpus.tokens[0].radix == 16                         ? table.parseHex
+                                                             : table.parseBinary;
+  u64 checksum = 0;
+  for (const Token& token : corpus.tokens) {
+    u64 value = 0;
+    kernel(corpus.text.data() + token.offset, token.length, value);
+    checksum = checksumStep(checksum, value);
+  }
+  return checksum;
+}
+
+u64 benchDispatch(const Corpus& corpus) {
+  u64 checksum = 0;
+  for (const Token& token : corpus.tokens) {
+    u64 value = 0;
+    intparse::parseRadix(corpus.text.data() + token.offset, token.length, token.radix, value);
+    checksum = checksumStep(checksum, value);
+  }
+  return checksum;
+}
+
+/// Decimal corpora a block of tokens at a time through the batch entry point; the
+/// others have nothing to batch and go through dispatch.
+struct TokenText {
+  const char* text;
+  std::size_t length;
+  const char* data() const { return text; }
+  std::size_t size() const { return length; }
+};
+
+u64 benchBatch(const Corpus& corpus) {
+  if (!corpus.tokens.empty() && corpus.tokens[0].radix != 10) {
+    return benchDispatch(corpus);
+  }
+  const std::size_t kBlock = 256;
+  TokenText texts[kBlock];
+  u64 values[kBlock];
+  intparse::ParseError errors[kBlock];
+  u64 checksum = 0;
+  for (std::size_t base = 0; base < corpus.tokens.size(); base += kBlock) {
+    const std::size_t count = std::min(kBlock, corpus.tokens.size() - base);
+    for (std::size_t i = 0; i < count; ++i) {
+      const Token& token = corpus.tokens[base + i];
+      texts[i] = TokenText{corpus.text.data() + token.offset, token.length};
+    }
+    intparse::parseDecimalBatch(texts, count, values, errors);
+    for (std::size_t i = 0; i < count; ++i) {
+      checksum = checksumStep(checksum, values[i]);
+    }
+  }
+  return checksum;
+}
+
+INTBENCH_REGISTER(intparse/scalar, benchTier<intparse::Isa::Scalar>);
+INTBENCH_REGISTER(intparse/swar, benchTier<intparse::Isa::Swar>);
+INTBENCH_REGISTER(intparse/sse41, benchTier<intparse::Isa::Sse41>);
+INTBENCH_REGISTER(intparse/avx2, benchTier<intparse::Isa::Avx2>);
+INTBENCH_REGISTER(intparse/avx512, benchTier<intparse::Isa::Avx512>);
+INTBENCH_REGISTER(intparse/dispatch, benchDispatch);
+INTBENCH_REGISTER(intparse/batch, benchBatch);
+
+}  // namespace
@@ -0,0 +1,377 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// /proc and /sys scanning benchmarks: procscan's scanners against the sscanf loops a
+/// monitoring agent usually has, over the recorded fixtures in bench/fixtures.
+///
+/// Usage: proc-bench [--root <dir>] [--pids <n>] [--min-time-ms <ms>]
+///
+/// The root is laid out like /, with proc/stat, proc/meminfo, proc/<pid>/stat and
+/// sys/fs/cgroup/cpu.stat under it, so --root / runs over the live system. parse rows
+/// time the text alone; poll rows add getting it, with fopen, fread and fclose every
+/// time against a ProcFile kept open and pread. Every row's fields are checked against
+/// sscanf's, so the smoke test is a correctness check.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "FixedWidthProcScan.h"
+
+#include <dirent.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::procscan;
+
+const std::size_t kBufferSize = 16384;
+const std::size_t kMaxCpus = 1024;
+
+u64 checksumStep(u64 checksum, u64 value) {
+  return checksum * 31 + value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Each kind of file reduced to a checksum of the fields an agent keeps.
+u64 checksumOf(const MemInfo& memory) {
+  u64 checksum = 0;
+  for (const KeyedField<MemInfo>& field : kMemInfoFields) {
+    checksum = checksumStep(checksum, memory.*field.member);
+  }
+  return checksum;
+}
+
+u64 checksumOf(const CpuTimes& times) {
+  const u64 columns[] = {times.user, times.nice,    times.system, times.idle,  times.iowait,
+                         times.irq,  times.softirq, times.steal,  times.guest, times.guestNice};
+  u64 checksum = 0;
+  for (u64 column : columns) {
+    checksum = checksumStep(checksum, column);
+  }
+  return checksum;
+}
+
+u64 checksumOf(const ProcStat& stat, const CpuTimes* cpus) {
+  u64 checksum = checksumOf(stat.total);
+  for (std::size_t cpu = 0; cpu < stat.cpuCount && cpu < kMaxCpus; ++cpu) {
+    checksum = checksumStep(checksum, checksumOf(cpus[cpu]));
+  }
+  const u64 counters[] = {stat.contextSwitches, stat.bootTime, stat.processes, stat.running, stat.blocked};
+  for (u64 counter : counters) {
+    checksum = checksumStep(checksum, counter);
+  }
+  return checksum;
+}
+
+u64 checksumOf(const PidStat& stat) {
+  const u64 fields[] = {static_cast<u64>(stat.pid),       static_cast<u64>(stat.state),
+                        static_cast<u64>(stat.parent),    stat.minorFaults,
+                        stat.majorFaults,                 stat.userTime,
+                        stat.systemTime,                  static_cast<u64>(stat.nice),
+                        static_cast<u64>(stat.threads),   stat.startTime,
+                        stat.virtualBytes,                static_cast<u64>(stat.residentPages)};
+  u64 checksum = 0;
+  for (u64 field : fields) {
+    checksum = checksumStep(checksum, field);
+  }
+  return checksum;
+}
+
+u64 checksumOf(const CgroupCpuStat& cpu) {
+  u64 checksum = 0;
+  for (const KeyedField<CgroupCpuStat>& field : kCgroupCpuStatFields) {
+    checksum = checksumStep(checksum, cpu.*field.member);
+  }
+  return checksum;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The sscanf baselines, a line at a time. Text is terminated.
+const char* nextLine(const char* line) {
+  const char* end = std::strchr(line, '\n');
+  return end != nullptr ? end + 1 : nullptr;
+}
+
+template <typename Struct, std::size_t kCount>
+void assignKeyed(const KeyedField<Struct> (&fields)[kCount], const char* key, u64 value, Struct& out) {
+  for (const KeyedField<Struct>& field : fields) {
+    if (std::strcmp(field.key, key) == 0) {
+      out.*field.member = value;
+      return;
+    }
+  }
+}
+
+u64 sscanfMemInfo(const char* text, std::size_t) {
+  MemInfo memory = {};
+  for (const char* line = text; line != nullptr && *line != '\0'; line = nextLine(line)) {
+    char key[64];
+    unsigned long long value;
+    if (std::sscanf(line, "%63[^:]: %llu", key, &value) == 2) {
+      assignKeyed(kMemInfoFields, key, value, memory);
+    }
+  }
+  return checksumOf(memory);
+}
+
+u64 sscanfProcStat(const char* text, std::size_t) {
+  ProcStat stat = {};
+  CpuTimes cpus[kMaxCpus] = {};
+  const KeyedField<ProcStat> kCounters[] = {
+      {"ctxt", &ProcStat::contextSwitches}, {"btime", &ProcStat::bootTime},
+      {"processes", &ProcStat::processes},  {"procs_running", &ProcStat::running},
+      {"procs_blocked", &ProcStat::blocked},
+  };
+  for (const char* line = text; line != nullptr && *line != '\0'; line = nextLine(line)) {
+    char key[32];
+    unsigned long long c[10] = {};
+    if (std::strncmp(line, "cpu", 3) == 0) {
+      std::sscanf(line, "%31s %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu", key, &c[0], &c[1], &c[2], &c[3],
+                  &c[4], &c[5], &c[6], &c[7], &c[8], &c[9]);
+      const CpuTimes times = {c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7], c[8], c[9]};
+      if (key[3] == '\0') {
+        stat.total = times;
+      } else {
+        const std::size_t cpu = std::strtoull(key + 3, nullptr, 10);
+        stat.cpuCount = cpu + 1 > stat.cpuCount ? cpu + 1 : stat.cpuCount;
+        if (cpu < kMaxCpus) {
+          cpus[cpu] = times;
+        }
+      }
+    } else if (std::sscanf(line, "%31s %llu", key, &c[0]) == 2) {
+      assignKeyed(kCounters, key, c[0], stat);
+    }
+  }
+  return checksumOf(stat, cpus);
+}
+
+u64 sscanfPidStat(const char* text, std::size_t) {
+  PidStat stat = {};
+  const char* close = std::strrchr(text, ')');
+  if (close == nullptr || std::sscanf(text, "%d", &stat.pid) != 1) {
+    return 0;
+  }
+  unsigned long long minorFaults, majorFaults, userTime, systemTime, startTime, virtualBytes;
+  long long nice, threads, resident;
+  int parent;
+  std::sscanf(close + 2, "%c %d %*d %*d %*d %*d %*u %llu %*u %llu %*u %llu %llu %*d %*d %*d %lld %lld %*d %llu %llu %lld",
+              &stat.state, &parent, &minorFaults, &majorFaults, &userTime, &systemTime, &nice, &threads, &startTime,
+              &virtualBytes, &resident);
+  stat.parent = parent;
+  stat.minorFaults = minorFaults;
+  stat.majorFaults = majorFaults;
+  stat.userTime = userTime;
+  stat.systemTime = systemTime;
+  stat.nice = nice;
+  stat.threads = threads;
+  stat.startTime = startTime;
+  stat.virtualBytes = virtualBytes;
+  stat.residentPages = resident;
+  return checksumOf(stat);
+}
+
+u64 sscanfCgroupCpu(const char* text, std::size_t) {
+  CgroupCpuStat cpu = {};
+  for (const char* line = text; line != nullptr && *line != '\0'; line = nextLine(line)) {
+    char key[64];
+    unsigned long long value;
+    if (std::sscanf(line, "%63s %llu", key, &value) == 2) {
+      assignKeyed(kCgroupCpuStatFields, key, value, cpu);
+    }
+  }
+  return checksumOf(cpu);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The same through procscan.
+u64 scanMemInfo(const char* text, std::size_t length) {
+  MemInfo memory = {};
+  scanKeyed(text, length, kMemInfoFields, memory);
+  return checksumOf(memory);
+}
+
+u64 scanStat(const char* text, std::size_t length) {
+  ProcStat stat = {};
+  CpuTimes cpus[kMaxCpus] = {};
+  scanProcStat(text, length, stat, cpus, kMaxCpus);
+  return checksumOf(stat, cpus);
+}
+
+u64 scanPid(const char* text, std::size_t length) {
+  PidStat stat = {};
+  scanPidStat(text, length, stat);
+  return checksumOf(stat);
+}
+
+u64 scanCgroupCpu(const char* text, std::size_t length) {
+  CgroupCpuStat cpu = {};
+  scanKeyed(text, length, kCgroupCpuStatFields, cpu);
+  return checksumOf(cpu);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// One kind of file: every path of it, its recorded text, and the files held open.
+struct FileSet {
+  const char* kind;
+  u64 (*sscanfParse)(const char*, std::size_t);
+  u64 (*scanParse)(const char*, std::size_t);
+  std::vector<std::string> paths;
+  std::vector<std::string> texts;
+  std::vector<std::unique_ptr<ProcFile>> files;
+};
+
+u64 parseSscanf(FileSet& set) {
+  u64 checksum = 0;
+  for (const std::string& text : set.texts) {
+    checksum = checksumStep(checksum, set.sscanfParse(text.c_str(), text.size()));
+  }
+  return checksum;
+}
+
+u64 parseScan(FileSet& set) {
+  u64 checksum = 0;
+  for (const std::string& text : set.texts) {
+    checksum = checksumStep(checksum, set.scanParse(text.data(), text.size()));
+  }
+  return checksum;
+}
+
+u64 pollStdio(FileSet& set) {
+  u64 checksum = 0;
+  char buffer[kBufferSize];
+  for (const std::string& path : set.paths) {
+    std::FILE* file = std::fopen(path.c_str(), "r");
+    const std::size_t length = file != nullptr ? std::fread(buffer, 1, sizeof(buffer) - 1, file) : 0;
+    if (file != nullptr) {
+      std::fclose(file);
+    }
+    buffer[length] = '\0';
+    checksum = checksumStep(checksum, set.sscanfParse(buffer, length));
+  }
+  return checksum;
+}
+
+u64 pollScan(FileSet& set) {
+  u64 checksum = 0;
+  char buffer[kBufferSize];
+  for (const std::unique_ptr<ProcFile>& file : set.files) {
+    const long length = file->read(buffer, sizeof(buffer));
+    checksum = checksumStep(checksum, set.scanParse(buffer, length > 0 ? static_cast<std::size_t>(length) : 0));
+  }
+  return checksum;
+}
+
+struct ProcBenchmark {
+  const char* name;
+  u64 (*run)(FileSet&);
+};
+
+const ProcBenchmark kBenchmarks[] = {
+    {"parse/sscanf", parseSscanf},
+    {"parse/procscan", parseScan},
+    {"poll/stdio", pollStdio},
+    {"poll/procscan", pollScan},
+};
+
+void addFile(FileSet& set, const std::string& path) {
+  std::unique_ptr<ProcFile> file(new ProcFile(path.c_str()));
+  char buffer[kBufferSize];
+  const long length = file->isOpen() ? file->read(buffer, sizeof(buffer)) : -1;
+  if (length > 0 && static_cast<std::size_t>(length) < sizeof(buffer)) {
+    set.paths.push_back(path);
+    set.texts.push_back(std::string(buffer, static_cast<std::size_t>(length)));
+    set.files.push_back(std::move(file));
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string root = ".";
+  std::size_t maxPids = 4096;
+  double minTimeMs = 200;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string arg = argv[i];
+    if (arg == "--root") {
+      root = argv[i + 1];
+    } else if (arg == "--pids") {
+      maxPids = std::strtoull(argv[i + 1], nullptr, 10);
+    } else if (arg == "--min-time-ms") {
+      minTimeMs = std::strtod(argv[i + 1], nullptr);
+    } else {
+      std::fprintf(stderr, "usage: %s [--root <dir>] [--pids <n>] [--min-time-ms <ms>]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  FileSet sets[] = {
+      {"meminfo", sscanfMemInfo, scanMemInfo, {}, {}, {}},
+      {"stat", sscanfProcStat, scanStat, {}, {}, {}},
+      {"pid-stat", sscanfPidStat, scanPid, {}, {}, {}},
+      {"cpu.stat", sscanfCgroupCpu, scanCgroupCpu, {}, {}, {}},
+  };
+  addFile(sets[0], root + "/proc/meminfo");
+  addFile(sets[1], root + "/proc/stat");
+  if (DIR* proc = opendir((root + "/proc").c_str())) {
+    while (const dirent* entry = readdir(proc)) {
+      if (entry->d_name[0] >= '1' && entry->d_name[0] <= '9' && sets[2].paths.size() < maxPids) {
+        addFile(sets[2], root + "/proc/" + entry->d_name + "/stat");
+      }
+    }
+    closedir(proc);
+  }
+  addFile(sets[3], root + "/sys/fs/cgroup/cpu.stat");
+
+  bool failed = false;
+  std::printf("%-9s %6s %-16s %10s %s\n", "file", "files", "benchmark", "ns/file", "check");
+  for (FileSet& set : sets) {
+    if (set.texts.empty()) {
+      std::printf("%-9s %6s (none under %s)\n", set.kind, "0", root.c_str());
+      continue;
+    }
+    const u64 expected = parseSscanf(set);
+    for (const ProcBenchmark& benchmark : kBenchmarks) {
+      using Clock = std::chrono::steady_clock;
+      double bestNs = 0;
+      double totalMs = 0;
+      bool matched = true;
+      do {
+        const Clock::time_point start = Clock::now();
+        const u64 checksum = benchmark.run(set);
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        // Live files change between reads, so only the recorded text has to match
+        matched = matched && (checksum == expected || std::strncmp(benchmark.name, "poll", 4) == 0);
+        bestNs = bestNs == 0 || ns < bestNs ? ns : bestNs;
+        totalMs += ns / 1e6;
+      } while (totalMs < minTimeMs);
+
+      std::printf("%-9s %6zu %-16s %10.1f %s\n", set.kind, set.texts.size(), benchmark.name,
+                  bestNs / static_cast<double>(set.texts.size()), matched ? "ok" : "MISMATCH");
+      failed = failed || !matched;
+    }
+  }
+  return failed ? 1 : 0;
+}
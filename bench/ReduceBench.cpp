@@ -0,0 +1,326 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// Parse and reduce benchmarks: a newline separated column of decimals summed, maxed
+/// and bucketed by intparse::parseReduce, against strtoull and against parsing the
+/// whole column into an array first and reducing that. The select rows keep the top
+/// 1% of values, with intparse::parseDecimalSelect against parsing then filtering, and
+/// the encode rows parse the codes column, 200 distinct values, into uint8_t dictionary
+/// codes with intparse::parseDecimalDictionary against into a 64-bit array.
+///
+/// Usage: reduce-bench [--tokens <n>] [--seed <n>] [--min-time-ms <ms>]
+///
+/// The columns are the decimal tokens of the log and csv corpora, plus a codes column
+/// of log tokens all drawn from the repeated pool. Every result is
+/// checked against the corpus's own values, so the smoke test is a correctness check.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "FixedWidthIntParse.h"
+#include "IntCorpus.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+
+namespace intparse = SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::intparse;
+using namespace intbench;
+
+const u64 kBucketWidth = 4096;
+const std::size_t kBuckets = 16;
+using Histogram = intparse::HistogramReducer<u64, kBuckets>;
+
+/// Selects keep values at or above this, set per corpus to its 99th percentile.
+u64 gThreshold = 0;
+
+u64 saturatingAdd(u64 sum, u64 value) {
+  return value > std::numeric_limits<u64>::max() - sum ? std::numeric_limits<u64>::max() : sum + value;
+}
+
+u64 histogramChecksum(const std::size_t (&counts)[kBuckets]) {
+  u64 checksum = 0;
+  for (std::size_t count : counts) {
+    checksum = checksum * 31 + count;
+  }
+  return checksum;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Materializing: every value goes into an array, which is then reduced.
+struct TokenText {
+  const char* text;
+  std::size_t length;
+
+  const char* data() const { return text; }
+  std::size_t size() const { return length; }
+};
+
+std::vector<TokenText> splitColumn(const std::string& column) {
+  std::vector<TokenText> tokens;
+  const char* p = column.data();
+  const char* const end = p + column.size();
+  while (p < end) {
+    const char* stop = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+    stop = stop != nullptr ? stop : end;
+    tokens.push_back(TokenText{p, static_cast<std::size_t>(stop - p)});
+    p = stop + 1;
+  }
+  return tokens;
+}
+
+std::vector<u64> parseColumn(const std::string& column) {
+  const std::vector<TokenText> tokens = splitColumn(column);
+  std::vector<u64> values(tokens.size());
+  std::vector<intparse::ParseError> errors(tokens.size());
+  intparse::parseDecimalBatch(tokens.data(), tokens.size(), values.data(), errors.data());
+  return values;
+}
+
+u64 sumStrtoull(const std::string& column) {
+  u64 sum = 0;
+  const char* p = column.c_str();
+  const char* const end = p + column.size();
+  while (p < end) {
+    char* stop;
+    sum = saturatingAdd(sum, std::strtoull(p, &stop, 10));
+    p = stop + 1;
+  }
+  return sum;
+}
+
+u64 sumMaterialized(const std::string& column) {
+  u64 sum = 0;
+  for (u64 value : parseColumn(column)) {
+    sum = saturatingAdd(sum, value);
+  }
+  return sum;
+}
+
+u64 maxMaterialized(const std::string& column) {
+  u64 max = 0;
+  for (u64 value : parseColumn(column)) {
+    max = value > max ? value : max;
+  }
+  return max;
+}
+
+u64 histogramMaterialized(const std::string& column) {
+  Histogram histogram(0, kBucketWidth);
+  for (u64 value : parseColumn(column)) {
+    histogram.add(value);
+  }
+  return histogramChecksum(histogram.counts);
+}
+
+u64 encodeMaterialized(const std::string& column) {
+  return sumMaterialized(column);
+}
+
+u64 selectMaterialized(const std::string& column) {
+  std::vector<u64> selected;
+  for (u64 value : parseColumn(column)) {
+    if (value >= gThreshold) {
+      selected.push_back(value);
+    }
+  }
+  u64 checksum = selected.size();
+  for (u64 value : selected) {
+    checksum = checksum * 31 + value;
+  }
+  return checksum;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fused: the values never leave the parser's block.
+u64 sumReduce(const std::string& column) {
+  intparse::SumReducer<u64> sum;
+  intparse::parseReduce<u64>(column.data(), column.size(), '\n', sum);
+  return sum.value;
+}
+
+u64 maxReduce(const std::string& column) {
+  intparse::MaxReducer<u64> max;
+  intparse::parseReduce<u64>(column.data(), column.size(), '\n', max);
+  return max.value;
+}
+
+u64 histogramReduce(const std::string& column) {
+  Histogram histogram(0, kBucketWidth);
+  intparse::parseReduce<u64>(column.data(), column.size(), '\n', histogram);
+  return histogramChecksum(histogram.counts);
+}
+
+/// A byte per value instead of eight; summing through the dictionary checks the codes.
+u64 encodeDictionary(const std::string& column) {
+  const std::vector<TokenText> tokens = splitColumn(column);
+  std::vector<std::uint8_t> codes(tokens.size());
+  std::vector<intparse::ParseError> errors(tokens.size());
+  intparse::DecimalDictionary<u64, std::uint8_t> dictionary;
+  intparse::parseDecimalDictionary(tokens.data(), tokens.size(), dictionary, codes.data(), errors.data());
+  u64 sum = 0;
+  for (std::uint8_t code : codes) {
+    sum = saturatingAdd(sum, dictionary.values[code]);
+  }
+  return sum;
+}
+
+/// Only the matches are written, but the output has to have room for every token.
+u64 selectPushdown(const std::string& column) {
+  const std::vector<TokenText> tokens = splitColumn(column);
+  std::vector<u64> selected(tokens.size());
+  const intparse::SelectResult result = intparse::parseDecimalSelect(
+      tokens.data(), tokens.size(), intparse::RangePredicate<u64>(gThreshold, ~u64{0}), selected.data(), nullptr);
+  u64 checksum = result.selected;
+  for (std::size_t i = 0; i < result.selected; ++i) {
+    checksum = checksum * 31 + selected[i];
+  }
+  return checksum;
+}
+
+/// What every benchmark of a reduction has to come to, from the corpus's values.
+u64 expectedSum(const std::vector<u64>& values) {
+  u64 sum = 0;
+  for (u64 value : values) {
+    sum = saturatingAdd(sum, value);
+  }
+  return sum;
+}
+
+u64 expectedMax(const std::vector<u64>& values) {
+  u64 max = 0;
+  for (u64 value : values) {
+    max = value > max ? value : max;
+  }
+  return max;
+}
+
+u64 expectedHistogram(const std::vector<u64>& values) {
+  Histogram histogram(0, kBucketWidth);
+  for (u64 value : values) {
+    histogram.add(value);
+  }
+  return histogramChecksum(histogram.counts);
+}
+
+u64 expectedSelect(const std::vector<u64>& values) {
+  u64 checksum = static_cast<u64>(std::count_if(values.begin(), values.end(), [](u64 x) { return x >= gThreshold; }));
+  for (u64 value : values) {
+    checksum = value >= gThreshold ? checksum * 31 + value : checksum;
+  }
+  return checksum;
+}
+
+/// Low cardinality benchmarks only run over the codes column.
+struct ReduceBenchmark {
+  const char* reduction;
+  const char* name;
+  u64 (*run)(const std::string&);
+  u64 (*expected)(const std::vector<u64>&);
+  bool lowCardinality;
+};
+
+const ReduceBenchmark kBenchmarks[] = {
+    {"sum", "strtoull", sumStrtoull, expectedSum, false},
+    {"sum", "materialize", sumMaterialized, expectedSum, false},
+    {"sum", "parse-reduce", sumReduce, expectedSum, false},
+    {"max", "materialize", maxMaterialized, expectedMax, false},
+    {"max", "parse-reduce", maxReduce, expectedMax, false},
+    {"histogram", "materialize", histogramMaterialized, expectedHistogram, false},
+    {"histogram", "parse-reduce", histogramReduce, expectedHistogram, false},
+    {"select", "materialize", selectMaterialized, expectedSelect, false},
+    {"select", "pushdown", selectPushdown, expectedSelect, false},
+    {"encode", "u64-array", encodeMaterialized, expectedSum, true},
+    {"encode", "dictionary", encodeDictionary, expectedSum, true},
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t tokenCount = 1000000;
+  u64 seed = 1;
+  double minTimeMs = 200;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string arg = argv[i];
+    if (arg == "--tokens") {
+      tokenCount = std::strtoull(argv[i + 1], nullptr, 10);
+    } else if (arg == "--seed") {
+      seed = std::strtoull(argv[i + 1], nullptr, 10);
+    } else if (arg == "--min-time-ms") {
+      minTimeMs = std::strtod(argv[i + 1], nullptr);
+    } else {
+      std::fprintf(stderr, "usage: %s [--tokens <n>] [--seed <n>] [--min-time-ms <ms>]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  bool failed = false;
+  std::printf("%-7s %-10s %-14s %10s %10s %s\n", "profile", "reduction", "benchmark", "ns/token", "MB/s", "check");
+  for (const char* name : {"log", "csv", "codes"}) {
+    ProfileConfig config = defaultConfig(std::strcmp(name, "csv") == 0 ? Profile::Csv : Profile::Log);
+    const bool lowCardinality = std::strcmp(name, "codes") == 0;
+    if (lowCardinality) {
+      config.repeatPercent = 100;
+      config.poolSize = 200;
+    }
+    const Corpus corpus = generateCorpus(config, tokenCount, seed);
+    std::string column;
+    for (const Token& token : corpus.tokens) {
+      column.append(corpus.text, token.offset, token.length);
+      column += '\n';
+    }
+    std::vector<u64> sorted = corpus.values;
+    std::sort(sorted.begin(), sorted.end());
+    gThreshold = sorted.empty() ? 0 : sorted[sorted.size() * 99 / 100];
+
+    for (const ReduceBenchmark& benchmark : kBenchmarks) {
+      if (benchmark.lowCardinality && !lowCardinality) {
+        continue;
+      }
+      const u64 expected = benchmark.expected(corpus.values);
+      using Clock = std::chrono::steady_clock;
+      double bestNs = 0;
+      double totalMs = 0;
+      bool matched = true;
+      do {
+        const Clock::time_point start = Clock::now();
+        const u64 result = benchmark.run(column);
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        matched = matched && result == expected;
+        bestNs = bestNs == 0 || ns < bestNs ? ns : bestNs;
+        totalMs += ns / 1e6;
+      } while (totalMs < minTimeMs);
+
+      const double tokens = static_cast<double>(corpus.tokens.size());
+      std::printf("%-7s %-10s %-14s %10.2f %10.1f %s\n", name, benchmark.reduction, benchmark.name,
+                  tokens == 0 ? 0.0 : bestNs / tokens,
+                  bestNs == 0 ? 0.0 : static_cast<double>(column.size()) * 1e3 / bestNs, matched ? "ok" : "MISMATCH");
+      failed = failed || !matched;
+    }
+  }
+  return failed ? 1 : 0;
+}
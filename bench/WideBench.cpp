@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// Long decimal string benchmarks: wideint::parseDecimal against the quadratic folds.
+///
+/// Usage: wide-bench [--max-digits <n>] [--seed <n>] [--min-time-ms <ms>]
+///
+/// Each input is random digits, from 20 up to --max-digits long in powers of ten. The
+/// digit fold multiplies the whole accumulator by ten per digit and the chunk fold by
+/// 10^19 per 19 digits; both are quadratic in the length. Every result is checked
+/// against the digit fold's, so the smoke test is a correctness check.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "FixedWidthWideInt.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+namespace {
+
+namespace intparse = SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::intparse;
+namespace wideint = SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::wideint;
+using u64 = std::uint64_t;
+using wideint::LimbVector;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Each benchmark converts the whole string into limbs.
+LimbVector benchDigitFold(const std::string& text) {
+  LimbVector value;
+  for (char ch : text) {
+    u64 carry = static_cast<u64>(ch - '0');
+    for (u64& limb : value) {
+      limb = wideint::detail::mulAdd(limb, 10, 0, carry);
+    }
+    if (carry != 0) {
+      value.push_back(carry);
+    }
+  }
+  return value;
+}
+
+LimbVector benchChunkFold(const std::string& text) {
+  LimbVector value;
+  std::size_t width = text.size() - (text.size() - 1) / 19 * 19;
+  for (std::size_t at = 0; at < text.size(); at += width, width = 19) {
+    u64 carry = 0;
+    intparse::parseDecimal(text.data() + at, width, carry);
+    for (u64& limb : value) {
+      limb = wideint::detail::mulAdd(limb, wideint::detail::kChunkPower, 0, carry);
+    }
+    if (carry != 0) {
+      value.push_back(carry);
+    }
+  }
+  return value;
+}
+
+LimbVector benchDivideConquer(const std::string& text) {
+  LimbVector value;
+  wideint::parseDecimal(text.data(), text.size(), value);
+  return value;
+}
+
+struct WideBenchmark {
+  const char* name;
+  LimbVector (*run)(const std::string&);
+};
+
+const WideBenchmark kBenchmarks[] = {
+    {"digit-fold", benchDigitFold},
+    {"chunk-fold", benchChunkFold},
+    {"divide-conquer", benchDivideConquer},
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t maxDigits = 100000;
+  u64 seed = 1;
+  double minTimeMs = 200;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string arg = argv[i];
+    if (arg == "--max-digits") {
+      maxDigits = std::strtoull(argv[i + 1], nullptr, 10);
+    } else if (arg == "--seed") {
+      seed = std::strtoull(argv[i + 1], nullptr, 10);
+    } else if (arg == "--min-time-ms") {
+      minTimeMs = std::strtod(argv[i + 1], nullptr);
+    } else {
+      std::fprintf(stderr, "usage: %s [--max-digits <n>] [--seed <n>] [--min-time-ms <ms>]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  std::mt19937_64 rng(seed);
+  bool failed = false;
+  std::printf("%8s %-16s %12s %10s %s\n", "digits", "benchmark", "us", "ns/digit", "check");
+  for (std::size_t digits = 20; digits <= maxDigits; digits *= digits == 20 ? 5 : 10) {
+    std::string text(digits, '0');
+    for (char& ch : text) {
+      ch = static_cast<char>('0' + rng() % 10);
+    }
+    text[0] = static_cast<char>('1' + rng() % 9);
+    const LimbVector expected = benchDigitFold(text);
+
+    for (const WideBenchmark& benchmark : kBenchmarks) {
+      using Clock = std::chrono::steady_clock;
+      double bestNs = 0;
+      double totalMs = 0;
+      bool matched = true;
+      do {
+        const Clock::time_point start = Clock::now();
+        const LimbVector value = benchmark.run(text);
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        matched = matched && value == expected;
+        bestNs = bestNs == 0 || ns < bestNs ? ns : bestNs;
+        totalMs += ns / 1e6;
+      } while (totalMs < minTimeMs);
+
+      std::printf("%8zu %-16s %12.2f %10.2f %s\n", digits, benchmark.name, bestNs / 1e3,
+                  bestNs / static_cast<double>(digits), matched ? "ok" : "MISMATCH");
+      failed = failed || !matched;
+    }
+  }
+  return failed ? 1 : 0;
+}
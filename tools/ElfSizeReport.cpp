@@ -0,0 +1,255 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reports what the literal suffixes cost in object code, by comparing the generated
+/// udl TUs against their plain <cstdint> twins built with the same flags.
+///
+/// Usage:
+///   elf-size-report [--require-zero <label>]... --group <label> <udl|plain> <object>... ...
+///
+/// For every label (an optimization level, typically) we print the .text, .rodata
+/// and .debug_info bytes of both styles and the difference, plus the number of
+/// emitted operator"" and checkValid_* symbols in the udl objects. Each
+/// --require-zero label fails the run unless the header added nothing there.
+///
+/// The ELF files are read directly rather than through nm/size so the report works
+/// the same wherever the build does.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__GNUG__)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+namespace {
+
+using u64 = std::uint64_t;
+
+struct Sizes {
+  u64 text = 0;
+  u64 rodata = 0;
+  u64 debugInfo = 0;
+  u64 literalOperators = 0;
+  u64 checkValids = 0;
+};
+
+struct Group {
+  Sizes udl;
+  Sizes plain;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Little-endian field reader over the raw file bytes.
+class Bytes {
+public:
+  explicit Bytes(std::string data) : data_(std::move(data)) {}
+
+  bool has(u64 offset, u64 size) const { return offset <= data_.size() && size <= data_.size() - offset; }
+
+  u64 read(u64 offset, unsigned size) const {
+    u64 value = 0;
+    for (unsigned i = 0; i < size; ++i) {
+      value |= static_cast<u64>(static_cast<unsigned char>(data_[offset + i])) << (8 * i);
+    }
+    return value;
+  }
+
+  const char* cstr(u64 offset) const { return data_.c_str() + offset; }
+  std::size_t size() const { return data_.size(); }
+
+private:
+  std::string data_;
+};
+
+bool isSection(const char* name, const char* section) {
+  const std::size_t length = std::strlen(section);
+  return std::strncmp(name, section, length) == 0 && (name[length] == '\0' || name[length] == '.');
+}
+
+std::string demangle(const char* name) {
+#if defined(__GNUG__)
+  int status = 0;
+  char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+  if (status == 0 && demangled != nullptr) {
+    std::string out = demangled;
+    std::free(demangled);
+    return out;
+  }
+#endif
+  return name;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Adds one ELF object's section sizes and symbol counts to sizes. Handles 32 and
+/// 64-bit little-endian files, which covers every target we build on.
+bool addObject(const std::string& path, Sizes& sizes) {
+  std::ifstream in(path, std::ios::binary);
+  std::ostringstream raw;
+  raw << in.rdbuf();
+  const Bytes elf(raw.str());
+
+  if (!in || elf.size() < 52 || std::memcmp(elf.cstr(0), "\x7f" "ELF", 4) != 0 || elf.read(5, 1) != 1) {
+    std::fprintf(stderr, "elf-size-report: %s is not a little-endian ELF file\n", path.c_str());
+    return false;
+  }
+
+  const bool is64 = elf.read(4, 1) == 2;
+  const unsigned word = is64 ? 8 : 4;
+  const u64 shoff = elf.read(is64 ? 0x28 : 0x20, word);
+  const u64 shentsize = elf.read(is64 ? 0x3a : 0x2e, 2);
+  const u64 shnum = elf.read(is64 ? 0x3c : 0x30, 2);
+  const u64 shstrndx = elf.read(is64 ? 0x3e : 0x32, 2);
+  if (!elf.has(shoff, shentsize * shnum) || shstrndx >= shnum) {
+    std::fprintf(stderr, "elf-size-report: %s has a bad section table\n", path.c_str());
+    return false;
+  }
+
+  struct Section {
+    u64 nameOffset, type, offset, size, link, entsize;
+  };
+  std::vector<Section> sections(shnum);
+  for (u64 i = 0; i < shnum; ++i) {
+    const u64 base = shoff + i * shentsize;
+    Section& section = sections[i];
+    section.nameOffset = elf.read(base, 4);
+    section.type = elf.read(base + 4, 4);
+    section.offset = elf.read(base + (is64 ? 0x18 : 0x10), word);
+    section.size = elf.read(base + (is64 ? 0x20 : 0x14), word);
+    section.link = elf.read(base + (is64 ? 0x28 : 0x18), 4);
+    section.entsize = elf.read(base + (is64 ? 0x38 : 0x24), word);
+  }
+
+  const Section& names = sections[shstrndx];
+  const u64 kShtSymtab = 2, kShtNobits = 8;
+  for (const Section& section : sections) {
+    if (section.nameOffset >= names.size) {
+      continue;
+    }
+    const char* name = elf.cstr(names.offset + section.nameOffset);
+    const u64 size = section.type == kShtNobits ? 0 : section.size;
+    if (isSection(name, ".text")) {
+      sizes.text += size;
+    } else if (isSection(name, ".rodata")) {
+      sizes.rodata += size;
+    } else if (isSection(name, ".debug_info")) {
+      sizes.debugInfo += size;
+    }
+
+    if (section.type != kShtSymtab || section.entsize == 0 || section.link >= shnum ||
+        !elf.has(section.offset, section.size)) {
+      continue;
+    }
+
+    // Defined function symbols only; undefined references don't cost us bytes
+    const Section& strings = sections[section.link];
+    const u64 kSttFunc = 2;
+    for (u64 offset = section.offset; offset + section.entsize <= section.offset + section.size;
+         offset += section.entsize) {
+      const u64 nameIndex = elf.read(offset, 4);
+      const u64 info = elf.read(offset + (is64 ? 4 : 12), 1);
+      const u64 shndx = elf.read(offset + (is64 ? 6 : 14), 2);
+      if ((info & 0xf) != kSttFunc || shndx == 0 || nameIndex >= strings.size) {
+        continue;
+      }
+      const std::string symbol = demangle(elf.cstr(strings.offset + nameIndex));
+      if (symbol.find("operator\"\"") != std::string::npos) {
+        ++sizes.literalOperators;
+      } else if (symbol.find("checkValid_") != std::string::npos) {
+        ++sizes.checkValids;
+      }
+    }
+  }
+  return true;
+}
+
+long long delta(u64 udl, u64 plain) {
+  return static_cast<long long>(udl) - static_cast<long long>(plain);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::vector<std::string> order;
+  std::map<std::string, Group> groups;
+  std::set<std::string> requireZero;
+
+  Sizes* current = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--require-zero" && i + 1 < argc) {
+      requireZero.insert(argv[++i]);
+    } else if (arg == "--group" && i + 2 < argc) {
+      const std::string label = argv[++i];
+      const std::string style = argv[++i];
+      if (groups.find(label) == groups.end()) {
+        order.push_back(label);
+      }
+      current = style == "udl" ? &groups[label].udl : &groups[label].plain;
+    } else if (current == nullptr) {
+      std::fprintf(stderr,
+                   "usage: %s [--require-zero <label>]... --group <label> <udl|plain> <object>... ...\n",
+                   argv[0]);
+      return 2;
+    } else if (!addObject(arg, *current)) {
+      return 1;
+    }
+  }
+
+  bool failed = false;
+  std::printf("%-6s %-12s %12s %12s %10s\n", "level", "section", "udl", "plain", "delta");
+  for (const std::string& label : order) {
+    const Group& group = groups[label];
+    const struct {
+      const char* name;
+      u64 udl, plain;
+    } rows[] = {
+        {".text", group.udl.text, group.plain.text},
+        {".rodata", group.udl.rodata, group.plain.rodata},
+        {".debug_info", group.udl.debugInfo, group.plain.debugInfo},
+        {"operator\"\"", group.udl.literalOperators, group.plain.literalOperators},
+        {"checkValid_*", group.udl.checkValids, group.plain.checkValids},
+    };
+
+    bool zero = true;
+    for (const auto& row : rows) {
+      std::printf("%-6s %-12s %12llu %12llu %+10lld\n", label.c_str(), row.name,
+                  static_cast<unsigned long long>(row.udl), static_cast<unsigned long long>(row.plain),
+                  delta(row.udl, row.plain));
+      // Debug info is expected to differ; only code, data and symbols have to match
+      zero = zero && (row.udl == row.plain || std::strcmp(row.name, ".debug_info") == 0);
+    }
+
+    if (requireZero.count(label) != 0) {
+      std::printf("%-6s %s\n", label.c_str(), zero ? "zero overhead" : "HEADER ADDED CODE OR DATA");
+      failed = failed || !zero;
+    }
+  }
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generates literal-heavy translation units used to measure what the header costs
+/// the compiler and the binary.
+///
+/// Every TU is written in two styles from the same seeded literal sequence:
+///   udl   - the literals use the suffixes from FixedWidthIntLiterals.h
+///   plain - the same values spelled with the <cstdint> macros
+/// Comparing the two styles isolates the cost of the header itself.
+///
+/// Usage: literal-tu-gen <out-dir> <tu-count> <literals-per-tu> <seed>
+///
+/// The output file names are LiteralTU_<style>_<index>.cpp so the build can list them
+/// without running the tool. A file is only rewritten when its contents change.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using u64 = std::uint64_t;
+
+////////////////////////////////////////////////////////////////////////////////
+/// The literal types, the suffix that spells them, and the <cstdint> equivalent.
+struct LiteralType {
+  const char* suffix;
+  const char* plainMacro;
+  u64 maxValue;
+};
+
+// clang-format off
+const LiteralType kTypes[] = {
+  {"_u8",  "UINT8_C",  0xffu},
+  {"_u16", "UINT16_C", 0xffffu},
+  {"_u32", "UINT32_C", 0xffffffffu},
+  {"_u64", "UINT64_C", 0xffffffffffffffffu},
+  {"_i8",  "INT8_C",   0x7fu},
+  {"_i16", "INT16_C",  0x7fffu},
+  {"_i32", "INT32_C",  0x7fffffffu},
+  {"_i64", "INT64_C",  0x7fffffffffffffffu},
+  {"_z",   "SIZE_C",   0xffffffffu}, // Kept to 32 bits so the TU also builds on 32-bit targets
+};
+// clang-format on
+const std::size_t kTypeCount = sizeof(kTypes) / sizeof(kTypes[0]);
+
+////////////////////////////////////////////////////////////////////////////////
+/// One generated literal: the digits as written (prefix included) and its type.
+struct Literal {
+  std::string digits;
+  std::size_t type;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writes value in the given radix with the C++ prefix for that radix.
+std::string spell(u64 value, unsigned radix) {
+  static const char kDigitChars[] = "0123456789abcdef";
+  std::string out;
+  do {
+    out.insert(out.begin(), kDigitChars[value % radix]);
+    value /= radix;
+  } while (value != 0);
+
+  switch (radix) {
+    case 2: return "0b" + out;
+    case 8: return out == "0" ? out : "0" + out;
+    case 16: return "0x" + out;
+    default: return out;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Produces the literal sequence for one TU. The mix is skewed the way real code is:
+/// small decimal values dominate, and a quarter of the literals repeat an earlier
+/// spelling (think 4096_z or 0xff_u8 sprinkled everywhere).
+std::vector<Literal> makeLiterals(std::mt19937_64& rng, std::size_t count) {
+  static const unsigned kRadixes[] = {10, 10, 10, 16, 16, 2, 8};
+  std::vector<Literal> literals;
+  literals.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (!literals.empty() && rng() % 4 == 0) {
+      literals.push_back(literals[rng() % literals.size()]);
+      continue;
+    }
+
+    const std::size_t type = rng() % kTypeCount;
+    const unsigned radix = kRadixes[rng() % (sizeof(kRadixes) / sizeof(kRadixes[0]))];
+
+    // Pick a bit width first so short literals are common and full-width ones still show up
+    const unsigned bits = 1u + static_cast<unsigned>(rng() % 64u);
+    u64 value = bits == 64 ? rng() : rng() & ((u64{1} << bits) - 1u);
+    value %= kTypes[type].maxValue == ~u64{0} ? ~u64{0} : kTypes[type].maxValue + 1u;
+    literals.push_back(Literal{spell(value, radix), type});
+  }
+  return literals;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Renders a TU. Each literal feeds an accumulator so none of them are dead code at -O0.
+std::string renderTU(const std::vector<Literal>& literals, std::size_t index, bool udl, u64 seed) {
+  std::ostringstream out;
+  out << "// Generated by literal-tu-gen (seed " << seed << ", TU " << index << "). Do not edit.\n";
+  if (udl) {
+    out << "#include \"FixedWidthIntLiterals.h\"\n"
+        << "using namespace SCW_FIXEDWIDTH_INT_LITERALS_NAMESPACE::intliterals;\n";
+  } else {
+    out << "#include <cstddef>\n"
+        << "#include <cstdint>\n"
+        << "#define SIZE_C(x) static_cast<std::size_t>(UINT64_C(x))\n";
+  }
+
+  out << "\nstd::uint64_t literalTU" << index << "(std::uint64_t acc) {\n";
+  for (const Literal& literal : literals) {
+    const LiteralType& type = kTypes[literal.type];
+    out << "  acc = acc * 31u + static_cast<std::uint64_t>(";
+    if (udl) {
+      out << literal.digits << type.suffix;
+    } else {
+      out << type.plainMacro << '(' << literal.digits << ')';
+    }
+    out << ");\n";
+  }
+  out << "  return acc;\n}\n";
+  return out.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writes the file only when the contents differ, so regenerating doesn't force rebuilds.
+bool writeIfChanged(const std::string& path, const std::string& contents) {
+  {
+    std::ifstream existing(path, std::ios::binary);
+    if (existing) {
+      std::ostringstream current;
+      current << existing.rdbuf();
+      if (current.str() == contents) {
+        return true;
+      }
+    }
+  }
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out << contents;
+  return static_cast<bool>(out);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc != 5) {
+    std::fprintf(stderr, "usage: %s <out-dir> <tu-count> <literals-per-tu> <seed>\n", argv[0]);
+    return 2;
+  }
+
+  const std::string outDir = argv[1];
+  const std::size_t tuCount = std::strtoull(argv[2], nullptr, 10);
+  const std::size_t literalCount = std::strtoull(argv[3], nullptr, 10);
+  const u64 seed = std::strtoull(argv[4], nullptr, 10);
+
+  for (std::size_t index = 0; index < tuCount; ++index) {
+    std::mt19937_64 rng(seed + index);
+    const std::vector<Literal> literals = makeLiterals(rng, literalCount);
+    for (int udl = 0; udl < 2; ++udl) {
+      const std::string path =
+          outDir + "/LiteralTU_" + (udl ? "udl_" : "plain_") + std::to_string(index) + ".cpp";
+      if (!writeIfChanged(path, renderTU(literals, index, udl != 0, seed))) {
+        std::fprintf(stderr, "literal-tu-gen: failed to write %s\n", path.c_str());
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,405 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2018 Steven C. Wilson
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without
+/// limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+/// the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+/// conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all copies or substantial
+/// portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+/// LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+/// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+/// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+/// Aggregates Clang -ftime-trace output per header construct and compares the
+/// result against a checked-in baseline.
+///
+/// Usage:
+///   time-trace-summary [--baseline <file>] [--time-tolerance <percent>]
+///                      [--write-baseline] <trace.json>...
+///
+/// For every construct we report the number of template instantiation events whose
+/// detail names it, and the wall time spent in them. Nested events of the same
+/// construct (ParseIntegerValue recursing into itself, say) only count their outermost
+/// duration so the time isn't counted twice.
+///
+/// Instantiation counts are deterministic for a given compiler, so any growth fails
+/// the gate. Times are noisy, so they only fail when they exceed the baseline by
+/// more than the tolerance. A construct the baseline doesn't list fails too, and so
+/// does an empty baseline, so the gate can't pass without something to hold to.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using u64 = std::uint64_t;
+
+////////////////////////////////////////////////////////////////////////////////
+/// The constructs we account for. The pattern is matched against the event detail,
+/// which for instantiation events is the fully qualified template name.
+struct Construct {
+  const char* name;
+  const char* pattern;
+};
+
+// clang-format off
+const Construct kConstructs[] = {
+  {"ParseIntegerValue", "ParseIntegerValue<"},
+  {"ParseBaseUnknown",  "ParseBaseUnknown<"},
+  {"createValue",       "createValue<"},
+  {"LiteralValue",      "LiteralValue<"},
+  {"RadixPowers",       "RadixPower"},
+  {"checkValid_*",      "checkValid_"},
+  {"operator\"\"",      "operator\"\""},
+};
+// clang-format on
+
+////////////////////////////////////////////////////////////////////////////////
+/// The parts of a trace event we care about.
+struct Event {
+  std::string name;
+  std::string detail;
+  u64 tid = 0;
+  u64 ts = 0;
+  u64 dur = 0;
+};
+
+struct Totals {
+  u64 count = 0;
+  u64 timeUs = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Just enough of a JSON reader to pull the events out of a trace file. Values we
+/// don't need are skipped rather than built.
+class TraceReader {
+public:
+  explicit TraceReader(const std::string& text) : text_(text) {}
+
+  bool read(std::vector<Event>& events) {
+    skipSpace();
+    if (!consume('{')) {
+      return false;
+    }
+    while (ok_ && !peekIs('}')) {
+      std::string key = readString();
+      expect(':');
+      if (key == "traceEvents") {
+        readEvents(events);
+      } else {
+        skipValue();
+      }
+      if (!consume(',')) {
+        break;
+      }
+    }
+    return ok_ && consume('}');
+  }
+
+private:
+  void readEvents(std::vector<Event>& events) {
+    expect('[');
+    while (ok_ && !peekIs(']')) {
+      Event event;
+      expect('{');
+      while (ok_ && !peekIs('}')) {
+        std::string key = readString();
+        expect(':');
+        if (key == "name") {
+          event.name = readString();
+        } else if (key == "tid") {
+          event.tid = readNumber();
+        } else if (key == "ts") {
+          event.ts = readNumber();
+        } else if (key == "dur") {
+          event.dur = readNumber();
+        } else if (key == "args") {
+          readArgs(event);
+        } else {
+          skipValue();
+        }
+        if (!consume(',')) {
+          break;
+        }
+      }
+      expect('}');
+      events.push_back(std::move(event));
+      if (!consume(',')) {
+        break;
+      }
+    }
+    expect(']');
+  }
+
+  void readArgs(Event& event) {
+    expect('{');
+    while (ok_ && !peekIs('}')) {
+      std::string key = readString();
+      expect(':');
+      if (key == "detail" && peekIs('"')) {
+        event.detail = readString();
+      } else {
+        skipValue();
+      }
+      if (!consume(',')) {
+        break;
+      }
+    }
+    expect('}');
+  }
+
+  std::string readString() {
+    std::string out;
+    if (!consume('"')) {
+      ok_ = false;
+      return out;
+    }
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+      char ch = text_[pos_++];
+      if (ch == '\\' && pos_ < text_.size()) {
+        ch = text_[pos_++];
+        switch (ch) {
+          case 'n': ch = '\n'; break;
+          case 't': ch = '\t'; break;
+          case 'u': pos_ += 4; ch = '?'; break;  // Never part of a name we match
+          default: break;
+        }
+      }
+      out.push_back(ch);
+    }
+    ++pos_;
+    return out;
+  }
+
+  u64 readNumber() {
+    skipSpace();
+    char* end = nullptr;
+    const double value = std::strtod(text_.c_str() + pos_, &end);
+    pos_ = static_cast<std::size_t>(end - text_.c_str());
+    return value < 0 ? 0 : static_cast<u64>(value);
+  }
+
+  void skipValue() {
+    skipSpace();
+    if (peekIs('"')) {
+      readString();
+    } else if (peekIs('{') || peekIs('[')) {
+      // Strings are the only place brackets can hide, so step over them as a unit
+      int depth = 0;
+      do {
+        if (peekIs('"')) {
+          readString();
+          continue;
+        }
+        const char ch = text_[pos_++];
+        depth += (ch == '{' || ch == '[') ? 1 : (ch == '}' || ch == ']') ? -1 : 0;
+      } while (ok_ && depth > 0 && pos_ < text_.size());
+    } else {
+      while (pos_ < text_.size() && text_[pos_] != ',' && text_[pos_] != '}' && text_[pos_] != ']') {
+        ++pos_;
+      }
+    }
+  }
+
+  void skipSpace() {
+    while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\n' || text_[pos_] == '\r' ||
+                                   text_[pos_] == '\t')) {
+      ++pos_;
+    }
+  }
+
+  bool peekIs(char ch) {
+    skipSpace();
+    return pos_ < text_.size() && text_[pos_] == ch;
+  }
+
+  bool consume(char ch) {
+    if (peekIs(ch)) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  void expect(char ch) {
+    if (!consume(ch)) {
+      ok_ = false;
+    }
+  }
+
+  const std::string& text_;
+  std::size_t pos_ = 0;
+  bool ok_ = true;
+};
+
+bool isInstantiation(const std::string& name) {
+  return name == "InstantiateClass" || name == "InstantiateFunction";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Adds one trace file's events into the per-construct totals.
+void accumulate(std::vector<Event>& events, std::map<std::string, Totals>& totals) {
+  std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+    return a.tid != b.tid ? a.tid < b.tid : a.ts < b.ts;
+  });
+
+  for (const Construct& construct : kConstructs) {
+    Totals& total = totals[construct.name];
+    u64 outerTid = ~u64{0};
+    u64 outerEnd = 0;
+    for (const Event& event : events) {
+      if (!isInstantiation(event.name) || event.detail.find(construct.pattern) == std::string::npos) {
+        continue;
+      }
+      ++total.count;
+      if (event.tid != outerTid || event.ts >= outerEnd) {
+        total.timeUs += event.dur;
+        outerTid = event.tid;
+        outerEnd = event.ts + event.dur;
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Baseline lines are "<construct> <count> <time-us>"; '#' starts a comment.
+std::map<std::string, Totals> readBaseline(const std::string& path, bool& found) {
+  std::map<std::string, Totals> baseline;
+  std::ifstream in(path);
+  found = static_cast<bool>(in);
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream fields(line);
+    std::string name;
+    Totals totals;
+    if (fields >> name >> totals.count >> totals.timeUs) {
+      baseline[name] = totals;
+    }
+  }
+  return baseline;
+}
+
+bool writeBaseline(const std::string& path, const std::map<std::string, Totals>& totals) {
+  std::ofstream out(path, std::ios::trunc);
+  out << "# Compile-time cost baseline for the literal-heavy TUs, written by time-trace-summary.\n"
+      << "# Regenerate with the update-compile-cost-baseline target when a cost change is intended.\n"
+      << "# construct instantiations time-us\n";
+  for (const Construct& construct : kConstructs) {
+    const Totals& total = totals.at(construct.name);
+    out << construct.name << ' ' << total.count << ' ' << total.timeUs << '\n';
+  }
+  return static_cast<bool>(out);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string baselinePath;
+  double tolerancePercent = 25.0;
+  bool updateBaseline = false;
+  std::vector<std::string> traces;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--baseline" && i + 1 < argc) {
+      baselinePath = argv[++i];
+    } else if (arg == "--time-tolerance" && i + 1 < argc) {
+      tolerancePercent = std::strtod(argv[++i], nullptr);
+    } else if (arg == "--write-baseline") {
+      updateBaseline = true;
+    } else {
+      traces.push_back(arg);
+    }
+  }
+
+  if (traces.empty() || (updateBaseline && baselinePath.empty())) {
+    std::fprintf(stderr,
+                 "usage: %s [--baseline <file>] [--time-tolerance <percent>] [--write-baseline] "
+                 "<trace.json>...\n",
+                 argv[0]);
+    return 2;
+  }
+
+  std::map<std::string, Totals> totals;
+  for (const Construct& construct : kConstructs) {
+    totals[construct.name] = Totals{};
+  }
+
+  for (const std::string& path : traces) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream text;
+    text << in.rdbuf();
+    std::vector<Event> events;
+    if (!in || !TraceReader(text.str()).read(events)) {
+      std::fprintf(stderr, "time-trace-summary: can't read trace %s\n", path.c_str());
+      return 1;
+    }
+    accumulate(events, totals);
+  }
+
+  if (updateBaseline) {
+    if (!writeBaseline(baselinePath, totals)) {
+      std::fprintf(stderr, "time-trace-summary: can't write %s\n", baselinePath.c_str());
+      return 1;
+    }
+    std::printf("Wrote baseline %s\n", baselinePath.c_str());
+    return 0;
+  }
+
+  bool haveBaseline = false;
+  const std::map<std::string, Totals> baseline =
+      baselinePath.empty() ? std::map<std::string, Totals>{} : readBaseline(baselinePath, haveBaseline);
+  if (!baselinePath.empty() && !haveBaseline) {
+    std::fprintf(stderr, "time-trace-summary: can't read baseline %s\n", baselinePath.c_str());
+    return 1;
+  }
+
+  bool failed = false;
+  std::printf("%-20s %14s %14s %12s %12s\n", "construct", "instantiations", "baseline", "time-us",
+              "baseline");
+  for (const Construct& construct : kConstructs) {
+    const Totals& total = totals[construct.name];
+    const auto it = baseline.find(construct.name);
+    if (it == baseline.end()) {
+      std::printf("%-20s %14llu %14s %12llu %12s%s\n", construct.name,
+                  static_cast<unsigned long long>(total.count), "-", static_cast<unsigned long long>(total.timeUs),
+                  "-", baselinePath.empty() ? "" : "  <-- not in baseline");
+      failed = failed || !baselinePath.empty();
+      continue;
+    }
+
+    const Totals& limit = it->second;
+    const bool countGrew = total.count > limit.count;
+    const bool timeGrew = total.timeUs > static_cast<double>(limit.timeUs) * (1.0 + tolerancePercent / 100.0);
+    std::printf("%-20s %14llu %14llu %12llu %12llu%s\n", construct.name,
+                static_cast<unsigned long long>(total.count), static_cast<unsigned long long>(limit.count),
+                static_cast<unsigned long long>(total.timeUs), static_cast<unsigned long long>(limit.timeUs),
+                countGrew ? "  <-- more instantiations" : timeGrew ? "  <-- slower" : "");
+    failed = failed || countGrew || timeGrew;
+  }
+
+  if (!baselinePath.empty() && baseline.empty()) {
+    std::fprintf(stderr, "time-trace-summary: baseline %s has no entries; run the update-compile-cost-baseline "
+                 "target with Clang 16 or newer and check it in.\n", baselinePath.c_str());
+  }
+  return failed ? 1 : 0;
+}